@@ -150,11 +150,11 @@ CraftEquipmentState::CraftEquipmentState(Base *base, size_t craft) : _lstScroll(
 	{
 		RuleItem *rule = _game->getMod()->getItem(*i);
 		auto isVehicle = rule->getVehicleUnit();
-		int cQty = isVehicle ? c->getVehicleCount(*i) : c->getItems()->getItem(*i);
+		int cQty = isVehicle ? c->getVehicleCount(*i) : c->getItems()->getItem(rule);
 
 		if ((isVehicle || rule->isInventoryItem()) && rule->canBeEquippedToCraftInventory() &&
 			_game->getSavedGame()->isResearched(rule->getRequirements()) &&
-			(_base->getStorageItems()->getItem(*i) > 0 || cQty > 0))
+			(_base->getStorageItems()->getItem(rule) > 0 || cQty > 0))
 		{
 			if (rule->getCategories().empty())
 			{
@@ -321,13 +321,13 @@ void CraftEquipmentState::initList()
 		}
 		else
 		{
-			cQty = c->getItems()->getItem(*i);
+			cQty = c->getItems()->getItem(rule);
 			_totalItems += cQty;
 			_totalItemStorageSize += cQty * rule->getSize();
 		}
 
 		if ((isVehicle || rule->isInventoryItem()) && rule->canBeEquippedToCraftInventory() &&
-			(_base->getStorageItems()->getItem(*i) > 0 || cQty > 0))
+			(_base->getStorageItems()->getItem(rule) > 0 || cQty > 0))
 		{
 			// check research requirements
 			if (!_game->getSavedGame()->isResearched(rule->getRequirements()))
@@ -388,7 +388,7 @@ void CraftEquipmentState::initList()
 			std::ostringstream ss, ss2;
 			if (_game->getSavedGame()->getMonthsPassed() > -1)
 			{
-				ss << _base->getStorageItems()->getItem(*i);
+				ss << _base->getStorageItems()->getItem(rule);
 			}
 			else
 			{
@@ -579,12 +579,12 @@ void CraftEquipmentState::updateQuantity()
 	}
 	else
 	{
-		cQty = c->getItems()->getItem(_items[_sel]);
+		cQty = c->getItems()->getItem(item);
 	}
 	std::ostringstream ss, ss2;
 	if (_game->getSavedGame()->getMonthsPassed() > -1)
 	{
-		ss << _base->getStorageItems()->getItem(_items[_sel]);
+		ss << _base->getStorageItems()->getItem(item);
 	}
 	else
 	{
@@ -637,7 +637,7 @@ void CraftEquipmentState::moveLeftByValue(int change)
 	RuleItem *item = _game->getMod()->getItem(_items[_sel], true);
 	int cQty = 0;
 	if (item->getVehicleUnit()) cQty = c->getVehicleCount(_items[_sel]);
-	else cQty = c->getItems()->getItem(_items[_sel]);
+	else cQty = c->getItems()->getItem(item);
 	if (change <= 0 || cQty <= 0) return;
 	change = std::min(cQty, change);
 	// Convert vehicle to item
@@ -652,7 +652,7 @@ void CraftEquipmentState::moveLeftByValue(int change)
 			// Put the vehicles and their ammo back as separate items.
 			if (_game->getSavedGame()->getMonthsPassed() != -1)
 			{
-				_base->getStorageItems()->addItem(_items[_sel], change);
+				_base->getStorageItems()->addItem(item, change);
 				_base->getStorageItems()->addItem(ammo, ammoPerVehicle * change);
 			}
 			// now delete the vehicles from the craft.
@@ -667,7 +667,7 @@ void CraftEquipmentState::moveLeftByValue(int change)
 		{
 			if (_game->getSavedGame()->getMonthsPassed() != -1)
 			{
-				_base->getStorageItems()->addItem(_items[_sel], change);
+				_base->getStorageItems()->addItem(item, change);
 			}
 			Collections::deleteIf(*c->getVehicles(), change,
 				[&](Vehicle* v)
@@ -679,12 +679,12 @@ void CraftEquipmentState::moveLeftByValue(int change)
 	}
 	else
 	{
-		c->getItems()->removeItem(_items[_sel], change);
+		c->getItems()->removeItem(item, change);
 		_totalItems -= change;
 		_totalItemStorageSize -= change * item->getSize();
 		if (_game->getSavedGame()->getMonthsPassed() > -1)
 		{
-			_base->getStorageItems()->addItem(_items[_sel], change);
+			_base->getStorageItems()->addItem(item, change);
 		}
 	}
 	updateQuantity();
@@ -709,7 +709,7 @@ void CraftEquipmentState::moveRightByValue(int change, bool suppressErrors)
 {
 	Craft *c = _base->getCrafts()->at(_craft);
 	RuleItem *item = _game->getMod()->getItem(_items[_sel], true);
-	int bqty = _base->getStorageItems()->getItem(_items[_sel]);
+	int bqty = _base->getStorageItems()->getItem(item);
 	if (_game->getSavedGame()->getMonthsPassed() == -1)
 	{
 		if (change == INT_MAX)
@@ -746,7 +746,7 @@ void CraftEquipmentState::moveRightByValue(int change, bool suppressErrors)
 						if (_game->getSavedGame()->getMonthsPassed() != -1)
 						{
 							_base->getStorageItems()->removeItem(ammo, ammoPerVehicle);
-							_base->getStorageItems()->removeItem(_items[_sel]);
+							_base->getStorageItems()->removeItem(item);
 						}
 						c->getVehicles()->push_back(new Vehicle(item, item->getVehicleClipSize(), size));
 					}
@@ -769,7 +769,7 @@ void CraftEquipmentState::moveRightByValue(int change, bool suppressErrors)
 					c->getVehicles()->push_back(new Vehicle(item, item->getVehicleClipSize(), size));
 					if (_game->getSavedGame()->getMonthsPassed() != -1)
 					{
-						_base->getStorageItems()->removeItem(_items[_sel]);
+						_base->getStorageItems()->removeItem(item);
 					}
 				}
 		}
@@ -806,12 +806,12 @@ void CraftEquipmentState::moveRightByValue(int change, bool suppressErrors)
 				_reload = false;
 			}
 		}
-		c->getItems()->addItem(_items[_sel],change);
+		c->getItems()->addItem(item,change);
 		_totalItems += change;
 		_totalItemStorageSize += change * item->getSize();
 		if (_game->getSavedGame()->getMonthsPassed() > -1)
 		{
-			_base->getStorageItems()->removeItem(_items[_sel],change);
+			_base->getStorageItems()->removeItem(item,change);
 		}
 	}
 	updateQuantity();
@@ -831,7 +831,7 @@ void CraftEquipmentState::btnClearClick(Action *)
 	if (_game->getSavedGame()->getMonthsPassed() == -1)
 	{
 		Craft* c = _base->getCrafts()->at(_craft);
-		c->getItems()->getContents()->clear();
+		c->getItems()->clear();
 	}
 }
 
@@ -864,7 +864,7 @@ void CraftEquipmentState::saveGlobalLoadout(int index)
 {
 	// clear the template
 	ItemContainer *tmpl = _game->getSavedGame()->getGlobalCraftLoadout(index);
-	tmpl->getContents()->clear();
+	tmpl->clear();
 
 	Craft *c = _base->getCrafts()->at(_craft);
 	// save only what is visible on the screen (can be DIFFERENT than what's really in the craft for various reasons)
@@ -878,11 +878,11 @@ void CraftEquipmentState::saveGlobalLoadout(int index)
 		}
 		else
 		{
-			cQty = c->getItems()->getItem(itemRule);
+			cQty = c->getItems()->getItem(item);
 		}
 		if (cQty > 0)
 		{
-			tmpl->addItem(itemRule, cQty);
+			tmpl->addItem(item, cQty);
 		}
 	}
 }
@@ -905,7 +905,7 @@ void CraftEquipmentState::loadGlobalLoadout(int index)
 	for (_sel = 0; _sel != _items.size(); ++_sel)
 	{
 		RuleItem *item = _game->getMod()->getItem(_items[_sel], true);
-		int tQty = tmpl->getItem(item->getName());
+		int tQty = tmpl->getItem(item);
 		moveRightByValue(tQty, true);
 	}
 
@@ -913,9 +913,9 @@ void CraftEquipmentState::loadGlobalLoadout(int index)
 	Craft *c = _base->getCrafts()->at(_craft);
 	std::string craftName = c->getName(_game->getLanguage());
 	std::vector<ReequipStat> _missingItems;
-	for (auto& templateItem : *tmpl->getContents())
+	for (auto& templateItem : tmpl->getContents())
 	{
-		RuleItem *item = _game->getMod()->getItem(templateItem.first, false);
+		const RuleItem *item = templateItem.first;
 		if (item)
 		{
 			int tQty = templateItem.second;
@@ -929,7 +929,7 @@ void CraftEquipmentState::loadGlobalLoadout(int index)
 			}
 			else
 			{
-				cQty = c->getItems()->getItem(item->getName());
+				cQty = c->getItems()->getItem(item);
 			}
 			int missing = tQty - cQty;
 			if (missing > 0)
@@ -170,7 +170,7 @@ void CraftWeaponsState::lstWeaponsClick(Action *)
 	{
 		_base->getStorageItems()->addItem(current->getRules()->getLauncherItem());
 		_base->getStorageItems()->addItem(current->getRules()->getClipItem(), current->getClipsLoaded());
-		_craft->addCraftStats(-current->getRules()->getBonusStats());
+		_craft->addCraftStats(-current->getRules()->getBonusStats(), _game->getMod());
 		// Make sure any extra shield is removed from craft too when the shield capacity decreases (exploit protection)
 		_craft->setShield(_craft->getShield());
 		delete current;
@@ -181,7 +181,7 @@ void CraftWeaponsState::lstWeaponsClick(Action *)
 	if (_weapons[_lstWeapons->getSelectedRow()] != 0)
 	{
 		CraftWeapon *sel = new CraftWeapon(_weapons[_lstWeapons->getSelectedRow()], 0);
-		_craft->addCraftStats(sel->getRules()->getBonusStats());
+		_craft->addCraftStats(sel->getRules()->getBonusStats(), _game->getMod());
 		_base->getStorageItems()->removeItem(sel->getRules()->getLauncherItem());
 		_craft->getWeapons()->at(_weapon) = sel;
 	}
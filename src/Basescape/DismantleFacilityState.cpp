@@ -125,7 +125,7 @@ void DismantleFacilityState::btnOkClick(Action *)
 			_game->getSavedGame()->setFunds(_game->getSavedGame()->getFunds() + _fac->getRules()->getBuildCost());
 			for (std::map<std::string, std::pair<int, int> >::const_iterator i = itemCost.begin(); i != itemCost.end(); ++i)
 			{
-				_base->getStorageItems()->addItem(i->first, i->second.first);
+				_base->getStorageItems()->addItem(_game->getMod()->getItem(i->first), i->second.first);
 			}
 		}
 		else
@@ -134,7 +134,7 @@ void DismantleFacilityState::btnOkClick(Action *)
 			_game->getSavedGame()->setFunds(_game->getSavedGame()->getFunds() + _fac->getRules()->getRefundValue());
 			for (std::map<std::string, std::pair<int, int> >::const_iterator i = itemCost.begin(); i != itemCost.end(); ++i)
 			{
-				_base->getStorageItems()->addItem(i->first, i->second.second);
+				_base->getStorageItems()->addItem(_game->getMod()->getItem(i->first), i->second.second);
 			}
 		}
 
@@ -658,7 +658,7 @@ void SellState::btnOkClick(Action *)
 					{
 						if ((*s)->getArmor()->getStoreItem())
 						{
-							_base->getStorageItems()->addItem((*s)->getArmor()->getStoreItem()->getType());
+							_base->getStorageItems()->addItem((*s)->getArmor()->getStoreItem());
 						}
 						_base->getSoldiers()->erase(s);
 						break;
@@ -219,10 +219,11 @@ void SoldierTransformationState::initTransformationData()
 	{
 		std::ostringstream s1, s2;
 		s1 << iter->second;
-		if (_game->getMod()->getItem(iter->first) != 0)
+		const RuleItem *itemRule = _game->getMod()->getItem(iter->first);
+		if (itemRule != 0)
 		{
-			s2 << _base->getStorageItems()->getItem(iter->first);
-			transformationPossible &= (_base->getStorageItems()->getItem(iter->first) >= iter->second);
+			s2 << _base->getStorageItems()->getItem(itemRule);
+			transformationPossible &= (_base->getStorageItems()->getItem(itemRule) >= iter->second);
 		}
 
 		_lstRequiredItems->addRow(3, tr(iter->first).c_str(), s1.str().c_str(), s2.str().c_str());
@@ -442,9 +443,10 @@ void SoldierTransformationState::btnStartClick(Action *action)
 
 	for (std::map<std::string, int>::const_iterator i = _transformationRule->getRequiredItems().begin(); i != _transformationRule->getRequiredItems().end(); ++i)
 	{
-		if (_game->getMod()->getItem(i->first) != 0)
+		const RuleItem *itemRule = _game->getMod()->getItem(i->first);
+		if (itemRule != 0)
 		{
-			_base->getStorageItems()->removeItem(i->first, i->second);
+			_base->getStorageItems()->removeItem(itemRule, i->second);
 		}
 	}
 
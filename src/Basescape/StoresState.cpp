@@ -282,7 +282,7 @@ void StoresState::initList(bool grandTotal)
 		if (!grandTotal)
 		{
 			// items in stores from this base only
-			qty += _base->getStorageItems()->getItem(*item);
+			qty += _base->getStorageItems()->getItem(rule);
 		}
 		else
 		{
@@ -157,17 +157,19 @@ TechTreeViewerState::TechTreeViewerState(const RuleResearch *r, const RuleManufa
 		_alreadyAvailableResearch.insert((*j)->getName());
 		discoveredSum += (*j)->getCost();
 	}
-	for (auto info : _game->getSavedGame()->getResearchRuleStatusRaw())
-	{
-		if (info.second == RuleResearch::RESEARCH_STATUS_DISABLED)
+	_game->getSavedGame()->getResearchRuleStatusRaw().forEach(
+		[&](StringId id, int status)
 		{
-			auto rr = _game->getMod()->getResearch(info.first, false);
-			if (rr)
+			if (status == RuleResearch::RESEARCH_STATUS_DISABLED)
 			{
-				_disabledResearch.insert(rr->getName());
+				auto rr = _game->getMod()->getResearch(id.str(), false);
+				if (rr)
+				{
+					_disabledResearch.insert(rr->getName());
+				}
 			}
 		}
-	}
+	);
 
 	int totalSum = 0;
 	const std::vector<std::string> &allResearch = _game->getMod()->getResearchList();
@@ -350,9 +352,6 @@ void TechTreeViewerState::initLists()
 		}
 		//
 
-		const std::vector<std::string> &researchList = _game->getMod()->getResearchList();
-		const std::vector<std::string> &manufactureList = _game->getMod()->getManufactureList();
-
 		// 0. common pre-calculation
 		const std::vector<const RuleResearch*> reqs = rule->getRequirements();
 		const std::vector<const RuleResearch*> deps = rule->getDependencies();
@@ -370,104 +369,42 @@ void TechTreeViewerState::initLists()
 		const std::vector<const RuleResearch*> free = rule->getGetOneFree();
 		const std::map<const RuleResearch*, std::vector<const RuleResearch*> > freeProtected = rule->getGetOneFreeProtected();
 
-		for (auto& j : manufactureList)
+		const RuleResearchReverseLinks &links = rule->getReverseLinks();
+		for (auto& i : links.requiredByManufacture)
 		{
-			RuleManufacture *temp = _game->getMod()->getManufacture(j);
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByManufacture.push_back(j);
-				}
-			}
+			requiredByManufacture.push_back(i->getName());
 		}
-
-		for (auto &f : _game->getMod()->getBaseFacilitiesList())
+		for (auto& i : links.requiredByFacilities)
 		{
-			RuleBaseFacility *temp = _game->getMod()->getBaseFacility(f);
-			for (auto &i : temp->getRequirements())
-			{
-				if (i == rule->getName())
-				{
-					requiredByFacilities.push_back(f);
-				}
-			}
+			requiredByFacilities.push_back(i->getType());
 		}
-
-		for (auto &item : _game->getMod()->getItemsList())
+		for (auto& i : links.requiredByItems)
 		{
-			RuleItem *temp = _game->getMod()->getItem(item);
-			for (auto &i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
-			for (auto &i : temp->getBuyRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByItems.push_back(item);
-				}
-			}
+			requiredByItems.push_back(i->getType());
 		}
-
-		for (auto& j : researchList)
+		for (auto& i : links.unlockedBy)
 		{
-			RuleResearch *temp = _game->getMod()->getResearch(j);
-			for (auto& i : temp->getUnlocked())
-			{
-				if (i == rule)
-				{
-					unlockedBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDisabled())
-			{
-				if (i == rule)
-				{
-					disabledBy.push_back(j);
-				}
-			}
-			for (auto& i : temp->getGetOneFree())
-			{
-				if (i == rule)
-				{
-					getForFreeFrom.push_back(j);
-				}
-			}
-			for (auto& itMap : temp->getGetOneFreeProtected())
-			{
-				for (auto& i : itMap.second)
-				{
-					if (i == rule)
-					{
-						getForFreeFrom.push_back(j);
-					}
-				}
-			}
-			if (!temp->getLookup().empty())
-			{
-				if (temp->getLookup() == rule->getName())
-				{
-					lookupOf.push_back(j);
-				}
-			}
-			for (auto& i : temp->getRequirements())
-			{
-				if (i == rule)
-				{
-					requiredByResearch.push_back(j);
-				}
-			}
-			for (auto& i : temp->getDependencies())
-			{
-				if (i == rule)
-				{
-					leadsTo.push_back(j);
-				}
-			}
+			unlockedBy.push_back(i->getName());
+		}
+		for (auto& i : links.disabledBy)
+		{
+			disabledBy.push_back(i->getName());
+		}
+		for (auto& i : links.getOneFreeFrom)
+		{
+			getForFreeFrom.push_back(i->getName());
+		}
+		for (auto& i : links.lookupOf)
+		{
+			lookupOf.push_back(i->getName());
+		}
+		for (auto& i : links.requiredByResearch)
+		{
+			requiredByResearch.push_back(i->getName());
+		}
+		for (auto& i : links.leadsTo)
+		{
+			leadsTo.push_back(i->getName());
 		}
 
 		// 1. item required
@@ -31,6 +31,7 @@
 #include "../Engine/RNG.h"
 #include "../Engine/Logger.h"
 #include "../Engine/Game.h"
+#include "../Engine/ThreadPool.h"
 #include "../Mod/Armor.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
@@ -39,6 +40,47 @@
 namespace OpenXcom
 {
 
+namespace
+{
+
+/**
+ * Results of a check that does not change any battle state, for a list of candidates.
+ * With worker threads all checks are done up front in parallel, otherwise each one is done
+ * when it's first asked for, so loops that stop early or skip candidates still skip the check.
+ * Callers go through results in the same order either way, so decisions don't depend on thread count.
+ */
+class CandidateChecks
+{
+	std::function<int(int)> _check;
+	mutable std::vector<int> _results;
+	mutable std::vector<char> _done;
+public:
+	/// Prepares checks, runs them on worker threads if there are any.
+	CandidateChecks(int count, std::function<int(int)> check) : _check(std::move(check)), _results(count)
+	{
+		if (ThreadPool::getThreadCount() > 1)
+		{
+			ThreadPool::parallelFor(count, [&](int i){ _results[i] = _check(i); });
+			_done.assign(count, true);
+		}
+		else
+		{
+			_done.assign(count, false);
+		}
+	}
+	/// Gets result of check for candidate.
+	int get(int i) const
+	{
+		if (!_done[i])
+		{
+			_results[i] = _check(i);
+			_done[i] = true;
+		}
+		return _results[i];
+	}
+};
+
+}
 
 /**
  * Sets up a BattleAIState.
@@ -689,6 +731,7 @@ void AIModule::setupAmbush()
 		Position origin = _save->getTileEngine()->getSightOriginVoxel(_aggroTarget);
 
 		// we'll use node positions for this, as it gives map makers a good degree of control over how the units will use the environment.
+		std::vector<Position> candidates;
 		for (std::vector<Node*>::const_iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
 		{
 			if ((*i)->isDummy())
@@ -707,10 +750,22 @@ void AIModule::setupAmbush()
 				tile->setPreview(10);
 				tile->setMarkerColor(13);
 			}
+			candidates.push_back(pos);
+		}
 
-			// make sure we can't be seen here.
-			Position target;
-			if (!_save->getTileEngine()->canTargetUnit(&origin, tile, &target, _aggroTarget, false, _unit) && !getSpottingUnits(pos))
+		// make sure we can't be seen here.
+		CandidateChecks hidden(candidates.size(),
+			[&](int i)
+			{
+				Position target;
+				return !_save->getTileEngine()->canTargetUnit(&origin, _save->getTile(candidates[i]), &target, _aggroTarget, false, _unit) && !getSpottingUnits(candidates[i]);
+			}
+		);
+
+		for (size_t i = 0; i < candidates.size(); ++i)
+		{
+			Position pos = candidates[i];
+			if (hidden.get(i))
 			{
 				_save->getPathfinding()->calculate(_unit, pos);
 				int ambushTUs = _save->getPathfinding()->getTotalTUCost();
@@ -1814,13 +1869,13 @@ bool AIModule::findFirePoint()
 		return false;
 	std::vector<Position> randomTileSearch = _save->getTileSearch();
 	RNG::shuffle(randomTileSearch);
-	Position target;
 	const int BASE_SYSTEMATIC_SUCCESS = 100;
 	const int FAST_PASS_THRESHOLD = 125;
 	bool waitIfOutsideWeaponRange = _unit->getGeoscapeSoldier() ? false : _unit->getUnitRules()->waitIfOutsideWeaponRange();
 	bool extendedFireModeChoiceEnabled = _save->getBattleGame()->getMod()->getAIExtendedFireModeChoice();
 	int bestScore = 0;
 	_attackAction->type = BA_RETHINK;
+	std::vector<Position> candidates;
 	for (std::vector<Position>::const_iterator i = randomTileSearch.begin(); i != randomTileSearch.end(); ++i)
 	{
 		Position pos = _unit->getPosition() + *i;
@@ -1828,19 +1883,41 @@ bool AIModule::findFirePoint()
 		if (tile == 0  ||
 			std::find(_reachableWithAttack.begin(), _reachableWithAttack.end(), _save->getTileIndex(pos))  == _reachableWithAttack.end())
 			continue;
-		int score = 0;
-		// i should really make a function for this
-		Position origin = pos.toVoxel() +
-			// 4 because -2 is eyes and 2 below that is the rifle (or at least that's my understanding)
-			Position(8,8, _unit->getHeight() + _unit->getFloatHeight() - tile->getTerrainLevel() - 4);
+		candidates.push_back(pos);
+	}
+
+	// can we shoot our target from each candidate
+	CandidateChecks canShoot(candidates.size(),
+		[&](int i)
+		{
+			Position pos = candidates[i];
+			// i should really make a function for this
+			Position origin = pos.toVoxel() +
+				// 4 because -2 is eyes and 2 below that is the rifle (or at least that's my understanding)
+				Position(8,8, _unit->getHeight() + _unit->getFloatHeight() - _save->getTile(pos)->getTerrainLevel() - 4);
+			Position target;
+			return (int)_save->getTileEngine()->canTargetUnit(&origin, _aggroTarget->getTile(), &target, _unit, false);
+		}
+	);
+	// number of units spotting each candidate we can shoot from, without workers only asked for reachable ones
+	CandidateChecks spotters(candidates.size(),
+		[&](int i)
+		{
+			return canShoot.get(i) ? getSpottingUnits(candidates[i]) : 0;
+		}
+	);
 
-		if (_save->getTileEngine()->canTargetUnit(&origin, _aggroTarget->getTile(), &target, _unit, false))
+	for (size_t i = 0; i < candidates.size(); ++i)
+	{
+		Position pos = candidates[i];
+		int score = 0;
+		if (canShoot.get(i))
 		{
 			_save->getPathfinding()->calculate(_unit, pos);
 			// can move here
 			if (_save->getPathfinding()->getStartDirection() != -1)
 			{
-				score = BASE_SYSTEMATIC_SUCCESS - getSpottingUnits(pos) * 10;
+				score = BASE_SYSTEMATIC_SUCCESS - spotters.get(i) * 10;
 				score += _unit->getTimeUnits() - _save->getPathfinding()->getTotalTUCost();
 				if (!_aggroTarget->checkViewSector(pos))
 				{
@@ -2758,25 +2835,32 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action, int radius)
 {
 	int bestScore = 2;
 	Position originVoxel = _save->getTileEngine()->getSightOriginVoxel(_unit);
-	Position targetVoxel;
-	for (std::vector<Node*>::const_iterator i = _save->getNodes()->begin(); i != _save->getNodes()->end(); ++i)
-	{
-		if ((*i)->isDummy())
-		{
-			continue;
-		}
-		int dist = Position::distance2d((*i)->getPosition(), _unit->getPosition());
-		if (dist <= 20 && dist > radius &&
-			_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile((*i)->getPosition()), O_FLOOR, &targetVoxel, _unit, false))
+	std::vector<Node*> *nodes = _save->getNodes();
+
+	// score of every node, nodes are only read so they can be scored on worker threads
+	CandidateChecks scores(nodes->size(),
+		[&](int n)
 		{
+			Node *node = nodes->at(n);
+			if (node->isDummy())
+			{
+				return INT_MIN;
+			}
+			Position targetVoxel;
+			int dist = Position::distance2d(node->getPosition(), _unit->getPosition());
+			if (dist > 20 || dist <= radius ||
+				!_save->getTileEngine()->canTargetTile(&originVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, _unit, false))
+			{
+				return INT_MIN;
+			}
 			int nodePoints = 0;
 			for (std::vector<BattleUnit*>::const_iterator j = _save->getUnits()->begin(); j != _save->getUnits()->end(); ++j)
 			{
-				dist = Position::distance2d((*i)->getPosition(), (*j)->getPosition());
+				dist = Position::distance2d(node->getPosition(), (*j)->getPosition());
 				if (!(*j)->isOut() && dist < radius)
 				{
 					Position targetOriginVoxel = _save->getTileEngine()->getSightOriginVoxel(*j);
-					if (_save->getTileEngine()->canTargetTile(&targetOriginVoxel, _save->getTile((*i)->getPosition()), O_FLOOR, &targetVoxel, *j, false))
+					if (_save->getTileEngine()->canTargetTile(&targetOriginVoxel, _save->getTile(node->getPosition()), O_FLOOR, &targetVoxel, *j, false))
 					{
 						if ((_unit->getFaction() == FACTION_HOSTILE && (*j)->getFaction() != FACTION_HOSTILE) ||
 							(_unit->getFaction() == FACTION_NEUTRAL && (*j)->getFaction() == FACTION_HOSTILE))
@@ -2793,11 +2877,17 @@ bool AIModule::getNodeOfBestEfficacy(BattleAction *action, int radius)
 					}
 				}
 			}
-			if (nodePoints > bestScore)
-			{
-				bestScore = nodePoints;
-				action->target = (*i)->getPosition();
-			}
+			return nodePoints;
+		}
+	);
+
+	for (size_t n = 0; n < nodes->size(); ++n)
+	{
+		int nodePoints = scores.get(n);
+		if (nodePoints > bestScore)
+		{
+			bestScore = nodePoints;
+			action->target = nodes->at(n)->getPosition();
 		}
 	}
 	return bestScore > 2;
@@ -318,6 +318,7 @@ void BattlescapeGame::handleAI(BattleUnit *unit)
 		// it might also help chryssalids realize they've zombified someone and need to move on
 		// it should also hide units when they've killed the guy spotting them
 		// it's also for good luck
+	_save->getPathfinding()->invalidateReachable(); // spotted units could change, AI need fresh reachable tiles
 
 	AIModule *ai = unit->getAIModule();
 	if (!ai)
@@ -479,6 +480,7 @@ bool BattlescapeGame::kneel(BattleUnit *bu)
  */
 void BattlescapeGame::endTurn()
 {
+	_save->getPathfinding()->invalidateReachable();
 	_debugPlay = _save->getDebugMode() && ((SDL_GetModState() & KMOD_CTRL) != 0) && (_save->getSide() != FACTION_NEUTRAL);
 	_currentAction.type = BA_NONE;
 	_currentAction.skillRules = nullptr;
@@ -1166,6 +1168,8 @@ void BattlescapeGame::popState()
 	_deleted.push_back(first);
 	_states.pop_front();
 	first->deinit();
+	// any finished action could move units or change terrain
+	_save->getPathfinding()->invalidateReachable();
 
 	// handle the end of this unit's actions
 	if (action.actor && noActionsPending(action.actor))
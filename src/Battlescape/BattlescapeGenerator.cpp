@@ -802,9 +802,9 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 	if (_base != 0)
 	{
 		ItemContainer *rememberMe = _save->getBaseStorageItems();
-		for (std::map<std::string, int>::iterator i = _base->getStorageItems()->getContents()->begin(); i != _base->getStorageItems()->getContents()->end(); ++i)
+		for (const auto &i : _base->getStorageItems()->getContents())
 		{
-			rememberMe->addItem(i->first, i->second);
+			rememberMe->addItem(i.first, i.second);
 		}
 	}
 
@@ -986,18 +986,18 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 	if (_craft != 0)
 	{
 		// add items that are in the craft
-		for (std::map<std::string, int>::iterator i = _craft->getItems()->getContents()->begin(); i != _craft->getItems()->getContents()->end(); ++i)
+		for (const auto &i : _craft->getItems()->getContents())
 		{
-			if (startingCondition != 0 && !startingCondition->isItemPermitted(i->first, _game->getMod(), _craft))
+			if (startingCondition != 0 && !startingCondition->isItemPermitted(i.first->getType(), _game->getMod(), _craft))
 			{
 				// send disabled items back to base
-				_base->getStorageItems()->addItem(i->first, i->second);
+				_base->getStorageItems()->addItem(i.first, i.second);
 			}
 			else
 			{
-				for (int count = 0; count < i->second; count++)
+				for (int count = 0; count < i.second; count++)
 				{
-					_save->createItemForTile(i->first, _craftInventoryTile);
+					_save->createItemForTile(i.first, _craftInventoryTile);
 				}
 			}
 		}
@@ -1008,9 +1008,9 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		if (_game->getSavedGame()->getMonthsPassed() != -1)
 		{
 			// add items that are in the base
-			for (std::map<std::string, int>::iterator i = _base->getStorageItems()->getContents()->begin(); i != _base->getStorageItems()->getContents()->end();)
+			for (const auto &i : _base->getStorageItems()->getContents())
 			{
-				RuleItem *rule = _game->getMod()->getItem(i->first, true);
+				const RuleItem *rule = i.first;
 				if (
 					// is item allowed in base defense?
 					rule->canBeEquippedBeforeBaseDefense() &&
@@ -1022,21 +1022,15 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 					// we know how to use this item
 					_game->getSavedGame()->isResearched(rule->getRequirements()))
 				{
-					for (int count = 0; count < i->second; count++)
+					for (int count = 0; count < i.second; count++)
 					{
-						_save->createItemForTile(i->first, _craftInventoryTile);
+						_save->createItemForTile(rule, _craftInventoryTile);
 					}
-					std::map<std::string, int>::iterator tmp = i;
-					++i;
 					if (!_baseInventory)
 					{
-						_base->getStorageItems()->removeItem(tmp->first, tmp->second);
+						_base->getStorageItems()->removeItem(rule, i.second);
 					}
 				}
-				else
-				{
-					++i;
-				}
 			}
 		}
 		// add items from crafts in base
@@ -1044,11 +1038,11 @@ void BattlescapeGenerator::deployXCOM(const RuleStartingCondition* startingCondi
 		{
 			if ((*c)->getStatus() == "STR_OUT")
 				continue;
-			for (std::map<std::string, int>::iterator i = (*c)->getItems()->getContents()->begin(); i != (*c)->getItems()->getContents()->end(); ++i)
+			for (const auto &i : (*c)->getItems()->getContents())
 			{
-				for (int count = 0; count < i->second; count++)
+				for (int count = 0; count < i.second; count++)
 				{
-					_save->createItemForTile(i->first, _craftInventoryTile);
+					_save->createItemForTile(i.first, _craftInventoryTile);
 				}
 			}
 		}
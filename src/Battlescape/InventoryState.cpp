@@ -1776,13 +1776,13 @@ void InventoryState::onMoveGroundInventoryToBase(Action *)
 	// step 1: move stuff from craft to base
 	for (std::vector<BattleItem*>::iterator i = groundInv->begin(); i != groundInv->end(); ++i)
 	{
-		std::string weaponRule = (*i)->getRules()->getType();
+		const RuleItem *weaponRule = (*i)->getRules();
 		// check all ammo slots first
 		for (int slot = 0; slot < RuleItem::AmmoSlotMax; ++slot)
 		{
 			if ((*i)->getAmmoForSlot(slot))
 			{
-				std::string ammoRule = (*i)->getAmmoForSlot(slot)->getRules()->getType();
+				const RuleItem *ammoRule = (*i)->getAmmoForSlot(slot)->getRules();
 				// only real ammo
 				if (weaponRule != ammoRule)
 				{
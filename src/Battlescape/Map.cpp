@@ -1799,7 +1799,10 @@ void Map::animate(bool redraw)
 	// animate tiles
 	for (int i = 0; i < _save->getMapSizeXYZ(); ++i)
 	{
-		_save->getTile(i)->animate();
+		if (_save->getTile(i)->animate())
+		{
+			_save->getPathfinding()->invalidateTerrain(_save->getTileCoords(i));
+		}
 	}
 
 	// animate vapor
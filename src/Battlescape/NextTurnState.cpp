@@ -557,7 +557,7 @@ bool NextTurnState::determineReinforcements()
 			{
 				continue;
 			}
-			if (wave.maxRuns != -1 && _battleGame->getReinforcementsMemory()[wave.type] >= wave.maxRuns)
+			if (wave.maxRuns != -1 && _battleGame->getReinforcementsMemory().get(wave.type) >= wave.maxRuns)
 			{
 				continue;
 			}
@@ -19,7 +19,7 @@
 #include <list>
 #include <algorithm>
 #include "Pathfinding.h"
-#include "PathfindingOpenSet.h"
+#include "PathfindingGraph.h"
 #include "../Savegame/SavedBattleGame.h"
 #include "../Savegame/Tile.h"
 #include "../Mod/Armor.h"
@@ -43,7 +43,7 @@ int Pathfinding::green = 4;
  * Sets up a Pathfinding.
  * @param save pointer to SavedBattleGame object.
  */
-Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _movementType(MT_WALK)
+Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPreviewed(false), _strafeMove(false), _totalTUCost(0), _modifierUsed(false), _ignoreUnits(false), _movementType(MT_WALK)
 {
 	_size = _save->getMapSizeXYZ();
 	// Initialize one node per tile
@@ -60,7 +60,10 @@ Pathfinding::Pathfinding(SavedBattleGame *save) : _save(save), _unit(0), _pathPr
  */
 Pathfinding::~Pathfinding()
 {
-	// Nothing more to do here.
+	for (std::vector<PathfindingGraph*>::iterator i = _graphs.begin(); i != _graphs.end(); ++i)
+	{
+		delete *i;
+	}
 }
 
 /**
@@ -145,6 +148,11 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *
 	{
 		abortPath(); // if bresenham failed, we shouldn't keep the path it was attempting, in case A* fails too.
 	}
+	// Long paths can use cluster graph first.
+	if (Options::oxceHierarchicalPathfinding && target == 0 && hierarchicalPath(startPosition, endPosition, sneak, maxTUCost))
+	{
+		return;
+	}
 	// Now try through A*.
 	if (!aStarPath(startPosition, endPosition, target, sneak, maxTUCost))
 	{
@@ -152,6 +160,67 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *
 	}
 }
 
+/**
+ * Finds a long path by searching the cluster graph first, then connecting
+ * its waypoints with A*. Each A* search only needs to cross one cluster.
+ * The unit information and movement type must have already been set.
+ * Path can be a bit longer than one found by A* over whole map.
+ * @param startPosition The position to start from.
+ * @param endPosition The position we want to reach.
+ * @param sneak Is the unit sneaking?
+ * @param maxTUCost Maximum time units the path can cost.
+ * @return True if a path was found, false if plain A* should be used.
+ */
+bool Pathfinding::hierarchicalPath(Position startPosition, Position endPosition, bool sneak, int maxTUCost)
+{
+	const int size = _unit->getArmor()->getSize();
+	PathfindingGraph *graph = 0;
+	for (std::vector<PathfindingGraph*>::iterator i = _graphs.begin(); i != _graphs.end(); ++i)
+	{
+		if ((*i)->isFor(_movementType, size))
+		{
+			graph = *i;
+			break;
+		}
+	}
+	if (!graph)
+	{
+		graph = new PathfindingGraph(_save, this, _movementType, size);
+		_graphs.push_back(graph);
+	}
+	if (!graph->isFar(startPosition, endPosition))
+	{
+		return false;
+	}
+
+	// graph only knows terrain, units on the way are avoided by A* later
+	std::vector<Position> waypoints;
+	_ignoreUnits = true;
+	const bool found = graph->findWaypoints(_unit, startPosition, endPosition, waypoints);
+	_ignoreUnits = false;
+	if (!found)
+	{
+		return false;
+	}
+
+	std::vector<int> path;
+	Position from = startPosition;
+	int spent = 0;
+	for (std::vector<Position>::const_iterator i = waypoints.begin(); i != waypoints.end(); ++i)
+	{
+		if (!aStarPath(from, *i, 0, sneak, maxTUCost - spent))
+		{
+			return false;
+		}
+		spent += getNode(*i)->getTUCost(false);
+		// paths are stored in reverse order, so later parts go first
+		path.insert(path.begin(), _path.begin(), _path.end());
+		from = *i;
+	}
+	_path = path;
+	return true;
+}
+
 /**
  * Calculates the shortest path using a simple A-Star algorithm.
  * The unit information and movement type must have already been set.
@@ -166,13 +235,14 @@ void Pathfinding::calculate(BattleUnit *unit, Position endPosition, BattleUnit *
 bool Pathfinding::aStarPath(Position startPosition, Position endPosition, BattleUnit *target, bool sneak, int maxTUCost)
 {
 	// reset every node, so we have to check them all
+	_openSet.clear();
 	for (std::vector<PathfindingNode>::iterator it = _nodes.begin(); it != _nodes.end(); ++it)
 		it->reset();
 
 	// start position is the first one in our "open" list
 	PathfindingNode *start = getNode(startPosition);
 	start->connect(0, 0, 0, endPosition);
-	PathfindingOpenSet openList;
+	PathfindingOpenSet &openList = _openSet;
 	openList.push(start);
 	bool missile = (target && maxTUCost == 10000);
 	// if the open list is empty, we've reached the end
@@ -232,11 +302,98 @@ bool Pathfinding::aStarPath(Position startPosition, Position endPosition, Battle
 int Pathfinding::getTUCost(Position startPosition, int direction, Position *endPosition, BattleUnit *unit, BattleUnit *target, bool missile)
 {
 	_unit = unit;
+	if (target || missile || _unit->getMovementType() != _movementType || !_save->getTile(startPosition))
+	{
+		return calculateTUCost(startPosition, direction, endPosition, target, missile, nullptr);
+	}
+
+	const int size = _unit->getArmor()->getSize() - 1;
+	const int numberOfParts = _unit->getArmor()->getTotalSize();
+	std::vector<EdgeCost> &edges = _edgeCosts[_movementType][size ? 1 : 0];
+	if (edges.empty())
+	{
+		edges.resize(_size * dir_max);
+	}
+	EdgeCost &edge = edges[_save->getTileIndex(startPosition) * dir_max + direction];
+	if (edge.cost == EdgeCost::Unknown)
+	{
+		// terrain part is the same for every unit, units and fire are checked below on every call
+		const bool ignoreUnits = _ignoreUnits;
+		_ignoreUnits = true;
+		edge.cost = EdgeCost::Blocked;
+		calculateTUCost(startPosition, direction, endPosition, nullptr, false, &edge);
+		_ignoreUnits = ignoreUnits;
+	}
+
+	directionToVector(direction, endPosition);
+	*endPosition += startPosition;
+	if (edge.cost == EdgeCost::Blocked)
+	{
+		return 255;
+	}
+
+	Position offsets[4] =
+	{
+		{ 0, 0, 0 },
+		{ 1, 0, 0 },
+		{ 0, 1, 0 },
+		{ 1, 1, 0 },
+	};
+
+	for (int i = 0; i < numberOfParts; ++i)
+	{
+		if (edge.overlapCheck & (1 << i))
+		{
+			// 2 or more voxels poking into this tile = no go
+			auto overlaping = _save->getTile(*endPosition + offsets[i])->getOverlappingUnit(_save, TUO_IGNORE_SMALL);
+			if (overlaping && overlaping != _unit)
+			{
+				return 255;
+			}
+		}
+	}
+
+	endPosition->z += edge.climb;
+	int totalCost = edge.cost;
+	for (int i = 0; i < numberOfParts; ++i)
+	{
+		Tile *destinationTile = _save->getTile(*endPosition + offsets[i]);
+		if (isBlocked(destinationTile, O_FLOOR, nullptr))
+		{
+			return 255;
+		}
+		totalCost += getFireTUCost(destinationTile);
+	}
+
+	if (edge.fallsDown)
+	{
+		return 0;
+	}
+	if (size)
+	{
+		totalCost /= numberOfParts;
+	}
+	return totalCost + getStrafeTUCost(direction);
+}
+
+/**
+ * Calculates the TU cost of moving from one tile to another (ONLY BETWEEN ADJACENT TILES).
+ * When edge is given, only terrain is checked: units, fire and strafing are skipped
+ * and the result is stored in edge instead, to be reused by getTUCost.
+ * @param startPosition The position to start from.
+ * @param direction The direction we are facing.
+ * @param endPosition The position we want to reach.
+ * @param target The target unit.
+ * @param missile Is this a guided missile?
+ * @param edge Terrain cost to fill, or null.
+ * @return TU cost or 255 if movement is impossible.
+ */
+int Pathfinding::calculateTUCost(Position startPosition, int direction, Position *endPosition, BattleUnit *target, bool missile, EdgeCost *edge)
+{
 	directionToVector(direction, endPosition);
 	*endPosition += startPosition;
 	const int size = _unit->getArmor()->getSize() - 1;
 	const int numberOfParts = _unit->getArmor()->getTotalSize();
-	bool armorAllowsStrafing = _unit->getArmor()->allowsStrafing(!size);
 	int maskOfPartsGoingUp = 0x0;
 	int maskOfPartsHoleUp = 0x0;
 	int maskOfPartsGoingDown = 0x0;
@@ -295,11 +452,18 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 		}
 		else if (!missile && _movementType == MT_FLY)
 		{
-			// 2 or more voxels poking into this tile = no go
-			auto overlaping = destinationTile[i]->getOverlappingUnit(_save, TUO_IGNORE_SMALL);
-			if (overlaping && overlaping != unit)
+			if (edge)
 			{
-				return 255;
+				edge->overlapCheck |= maskCurrentPart;
+			}
+			else
+			{
+				// 2 or more voxels poking into this tile = no go
+				auto overlaping = destinationTile[i]->getOverlappingUnit(_save, TUO_IGNORE_SMALL);
+				if (overlaping && overlaping != _unit)
+				{
+					return 255;
+				}
 			}
 		}
 
@@ -377,7 +541,7 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 		else if (direction >= DIR_UP && !fellDown)
 		{
 			// check if we can go up or down through gravlift or fly
-			if (validateUpDown(unit, startTile[i]->getPosition(), direction, missile))
+			if (validateUpDown(_unit, startTile[i]->getPosition(), direction, missile))
 			{
 				cost = 8; // vertical movement by flying suit or grav lift
 			}
@@ -441,15 +605,9 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 		}
 
 		cost += wallcost;
-		if (_unit->getFaction() != FACTION_PLAYER &&
-			_unit->getSpecialAbility() < SPECAB_BURNFLOOR &&
-			destinationTile[i]->getFire() > 0)
-			cost += 32; // try to find a better path, but don't exclude this path entirely.
-
-		// TFTD thing: underwater tiles on fire or filled with smoke cost 2 TUs more for whatever reason.
-		if (_save->getDepth() > 0 && (destinationTile[i]->getFire() > 0 || destinationTile[i]->getSmoke() > 0))
+		if (!edge)
 		{
-			cost += 2;
+			cost += getFireTUCost(destinationTile[i]);
 		}
 		totalCost += cost;
 	}
@@ -465,10 +623,16 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 	}
 	else if (direction == DIR_DOWN && maskOfPartsFalling == maskArmor)
 	{
+		if (edge)
+		{
+			edge->cost = totalCost;
+			edge->fallsDown = true;
+		}
 		return 0;
 	}
 
 	// for bigger sized units, check the path between parts in an X shape at the end position
+	const int partsCost = totalCost;
 	if (size)
 	{
 		totalCost /= numberOfParts;
@@ -488,11 +652,54 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 			return 255;
 	}
 
+	if (edge)
+	{
+		edge->cost = partsCost;
+		edge->climb = endPosition->z - startPosition.z - dir_z[direction];
+		return totalCost;
+	}
+
+	totalCost += getStrafeTUCost(direction);
+
+	if (missile)
+		return 0;
+	else
+		return totalCost;
+}
+
+/**
+ * Gets the extra TU cost of moving into a tile that is burning or full of smoke.
+ * @param tile Destination tile.
+ * @return Extra TU cost.
+ */
+int Pathfinding::getFireTUCost(Tile *tile) const
+{
+	int cost = 0;
+	if (_unit->getFaction() != FACTION_PLAYER &&
+		_unit->getSpecialAbility() < SPECAB_BURNFLOOR &&
+		tile->getFire() > 0)
+		cost += 32; // try to find a better path, but don't exclude this path entirely.
+
+	// TFTD thing: underwater tiles on fire or filled with smoke cost 2 TUs more for whatever reason.
+	if (_save->getDepth() > 0 && (tile->getFire() > 0 || tile->getSmoke() > 0))
+	{
+		cost += 2;
+	}
+	return cost;
+}
+
+/**
+ * Gets the extra TU cost of strafing in a direction.
+ * @param direction The direction of move.
+ * @return Extra TU cost.
+ */
+int Pathfinding::getStrafeTUCost(int direction)
+{
 	// Strafing costs +1 for forwards-ish or sidewards, propose +2 for backwards-ish directions
 	// Maybe if flying then it makes no difference?
 	if (Options::strafe && _strafeMove)
 	{
-		if (!armorAllowsStrafing)
+		if (!_unit->getArmor()->allowsStrafing(_unit->getArmor()->getSize() == 1))
 		{
 			// Armor doesn't support strafing, turn off strafe move and continue
 			_strafeMove = false;
@@ -508,16 +715,13 @@ int Pathfinding::getTUCost(Position startPosition, int direction, Position *endP
 			{
 				if (_unit->getDirection() != direction)
 				{
-					totalCost += 1;
+					return 1;
 				}
 			}
 		}
 	}
 
-	if (missile)
-		return 0;
-	else
-		return totalCost;
+	return 0;
 }
 
 /**
@@ -599,7 +803,7 @@ bool Pathfinding::isBlocked(Tile *tile, const int part, BattleUnit *missileTarge
 			tileNorth->getMapData(O_OBJECT)->getBigWall() == BIGWALLEASTANDSOUTH))
 			return true; // blocking part
 	}
-	if (part == O_FLOOR)
+	if (part == O_FLOOR && !_ignoreUnits)
 	{
 		if (tile->getUnit())
 		{
@@ -1139,23 +1343,70 @@ bool Pathfinding::bresenhamPath(Position origin, Position target, BattleUnit *ta
 
 /**
  * Locates all tiles reachable to @a *unit with a TU cost no more than @a tuMax.
- * Uses Dijkstra's algorithm.
+ * Uses Dijkstra's algorithm. Result of last search is cached, so asking again
+ * for the same unit with same or smaller budget does not need to search again.
  * @param unit Pointer to the unit.
- * @param tuMax The maximum cost of the path to each tile.
+ * @param cost Cost of action the unit wants to do after moving.
  * @return An array of reachable tiles, sorted in ascending order of cost. The first tile is the start location.
  */
 std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleActionCost &cost)
 {
-	const Position start = unit->getPosition();
 	int tuMax = unit->getTimeUnits() - cost.Time;
 	int energyMax = unit->getEnergy() - cost.Energy;
+	// "cost / 2 > energyMax" is same as "cost > energyMax * 2 + 1"
+	int costMax = std::min(tuMax, energyMax * 2 + 1);
+
+	const ReachableCache &cache = _reachableCache;
+	if (cache.unit != unit ||
+		cache.position != unit->getPosition() ||
+		cache.direction != unit->getDirection() ||
+		cache.movementType != _movementType ||
+		cache.strafeMove != _strafeMove ||
+		cache.costMax < costMax)
+	{
+		// search with whole budget of unit, later calls with action cost can reuse it
+		fillReachableCache(unit, std::max(costMax, std::min(unit->getTimeUnits(), unit->getEnergy() * 2 + 1)));
+	}
+
+	std::vector<int> tiles;
+	tiles.reserve(cache.tiles.size());
+	for (std::vector<std::pair<int, int> >::const_iterator it = cache.tiles.begin(); it != cache.tiles.end() && it->first <= costMax; ++it)
+	{
+		tiles.push_back(it->second);
+	}
+	if (tiles.empty())
+	{
+		// start location is always reachable
+		tiles.push_back(_save->getTileIndex(unit->getPosition()));
+	}
+	return tiles;
+}
+
+/**
+ * Runs Dijkstra's algorithm from position of unit and stores all tiles it can reach in cache.
+ * @param unit Pointer to the unit.
+ * @param costMax The maximum cost of the path to each tile.
+ */
+void Pathfinding::fillReachableCache(BattleUnit *unit, int costMax)
+{
+	const Position start = unit->getPosition();
+	ReachableCache &cache = _reachableCache;
+	cache.unit = unit;
+	cache.position = start;
+	cache.direction = unit->getDirection();
+	cache.costMax = costMax;
+	cache.movementType = _movementType;
+	cache.strafeMove = _strafeMove;
+	cache.tiles.clear();
+
+	_openSet.clear();
 	for (std::vector<PathfindingNode>::iterator it = _nodes.begin(); it != _nodes.end(); ++it)
 	{
 		it->reset();
 	}
 	PathfindingNode *startNode = getNode(start);
 	startNode->connect(0, 0, 0);
-	PathfindingOpenSet unvisited;
+	PathfindingOpenSet &unvisited = _openSet;
 	unvisited.push(startNode);
 	std::vector<PathfindingNode*> reachable;
 	while (!unvisited.empty())
@@ -1170,8 +1421,7 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleAction
 			int tuCost = getTUCost(currentPos, direction, &nextPos, unit, 0, false);
 			if (tuCost == 255) // Skip unreachable / blocked
 				continue;
-			if (currentNode->getTUCost(false) + tuCost > tuMax ||
-				(currentNode->getTUCost(false) + tuCost) / 2 > energyMax) // Run out of TUs/Energy
+			if (currentNode->getTUCost(false) + tuCost > costMax) // Run out of TUs/Energy
 				continue;
 			PathfindingNode *nextNode = getNode(nextPos);
 			if (nextNode->isChecked()) // Our algorithm means this node is already at minimum cost.
@@ -1188,13 +1438,60 @@ std::vector<int> Pathfinding::findReachable(BattleUnit *unit, const BattleAction
 		reachable.push_back(currentNode);
 	}
 	std::sort(reachable.begin(), reachable.end(), MinNodeCosts());
-	std::vector<int> tiles;
-	tiles.reserve(reachable.size());
+	cache.tiles.reserve(reachable.size());
 	for (std::vector<PathfindingNode*>::const_iterator it = reachable.begin(); it != reachable.end(); ++it)
 	{
-		tiles.push_back(_save->getTileIndex((*it)->getPosition()));
+		cache.tiles.push_back(std::make_pair((*it)->getTUCost(false), _save->getTileIndex((*it)->getPosition())));
 	}
-	return tiles;
+}
+
+/**
+ * Marks terrain around position as changed, so cached move costs and cluster graphs for long paths get updated.
+ * @param pos Position of changed tile.
+ * @param radius Radius of changed area in tiles.
+ */
+void Pathfinding::invalidateTerrain(Position pos, int radius)
+{
+	for (std::vector<PathfindingGraph*>::iterator i = _graphs.begin(); i != _graphs.end(); ++i)
+	{
+		(*i)->invalidate(pos, radius);
+	}
+
+	// move cost reads tiles up to two steps away from start tile (big units, walls of neighbours, stairs and falling)
+	const int margin = radius + 2;
+	const Position from = Position(std::max(0, pos.x - margin), std::max(0, pos.y - margin), std::max(0, pos.z - 2));
+	const Position to = Position(std::min(_save->getMapSizeX() - 1, pos.x + margin), std::min(_save->getMapSizeY() - 1, pos.y + margin), std::min(_save->getMapSizeZ() - 1, pos.z + 2));
+	for (auto &edgesBySize : _edgeCosts)
+	{
+		for (auto &edges : edgesBySize)
+		{
+			if (edges.empty())
+			{
+				continue;
+			}
+			for (int z = from.z; z <= to.z; ++z)
+			{
+				for (int y = from.y; y <= to.y; ++y)
+				{
+					for (int x = from.x; x <= to.x; ++x)
+					{
+						const int index = _save->getTileIndex(Position(x, y, z)) * dir_max;
+						std::fill(edges.begin() + index, edges.begin() + index + dir_max, EdgeCost());
+					}
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Forgets cached results of findReachable. Needs to be called when anything on the battlescape
+ * could change: units moved, terrain destroyed, doors opened or new units spotted.
+ */
+void Pathfinding::invalidateReachable()
+{
+	_reachableCache.unit = nullptr;
+	_reachableCache.tiles.clear();
 }
 
 /**
@@ -20,6 +20,7 @@
 #include <vector>
 #include "Position.h"
 #include "PathfindingNode.h"
+#include "PathfindingOpenSet.h"
 #include "../Mod/MapData.h"
 
 namespace OpenXcom
@@ -28,6 +29,7 @@ namespace OpenXcom
 class SavedBattleGame;
 class Tile;
 class BattleUnit;
+class PathfindingGraph;
 struct BattleActionCost;
 
 /**
@@ -43,12 +45,14 @@ private:
 
 	SavedBattleGame *_save;
 	std::vector<PathfindingNode> _nodes;
+	PathfindingOpenSet _openSet;
 	int _size;
 	BattleUnit *_unit;
 	bool _pathPreviewed;
 	bool _strafeMove;
 	int _totalTUCost;
 	bool _modifierUsed;
+	bool _ignoreUnits;
 	MovementType _movementType;
 	/// Gets the node at certain position.
 	PathfindingNode *getNode(Position pos);
@@ -58,11 +62,53 @@ private:
 	bool bresenhamPath(Position origin, Position target, BattleUnit *missileTarget, bool sneak = false, int maxTUCost = 1000);
 	/// Tries to find a path between two positions.
 	bool aStarPath(Position origin, Position target, BattleUnit *missileTarget, bool sneak = false, int maxTUCost = 1000);
+	/// Tries to find a long path using cluster graph and A* between its waypoints.
+	bool hierarchicalPath(Position origin, Position target, bool sneak = false, int maxTUCost = 1000);
 	/// Determines whether a unit can fall down from this tile.
 	bool canFallDown(Tile *destinationTile) const;
 	/// Determines whether a unit can fall down from this tile.
 	bool canFallDown(Tile *destinationTile, int size) const;
 	std::vector<int> _path;
+
+	/// Last flood fill done by findReachable, reused while the unit and battle state don't change.
+	struct ReachableCache
+	{
+		BattleUnit *unit = nullptr;
+		Position position;
+		int direction = -1;
+		int costMax = -1;
+		MovementType movementType = MT_WALK;
+		bool strafeMove = false;
+		/// Cost and tile index of every reachable tile, sorted by cost.
+		std::vector<std::pair<int, int>> tiles;
+	};
+	ReachableCache _reachableCache;
+	/// Terrain part of move cost, shared by all units with same movement type and size.
+	struct EdgeCost
+	{
+		static const short Unknown = -1;
+		static const short Blocked = -2;
+		/// Cost summed over all unit parts, or one of special values above.
+		short cost = Unknown;
+		/// Change of level at end of move, caused by stairs or falling.
+		signed char climb = 0;
+		/// Mask of unit parts that need check for overlapping flying units.
+		unsigned char overlapCheck = 0;
+		/// Move is falling down a level, it costs nothing.
+		bool fallsDown = false;
+	};
+	/// Lazily filled terrain costs, dir_max entries per tile, for each movement type and unit size.
+	std::vector<EdgeCost> _edgeCosts[MT_SINK + 1][2];
+	/// Calculates TU cost of move without using cached terrain costs.
+	int calculateTUCost(Position startPosition, int direction, Position *endPosition, BattleUnit *target, bool missile, EdgeCost *edge);
+	/// Gets extra TU cost of moving into a burning or smoky tile.
+	int getFireTUCost(Tile *tile) const;
+	/// Gets extra TU cost of strafing, turns strafing off if unit can't do it.
+	int getStrafeTUCost(int direction);
+	/// Cluster graphs for long paths, one for each movement type and unit size.
+	std::vector<PathfindingGraph*> _graphs;
+	/// Runs a flood fill for findReachable and stores it in cache.
+	void fillReachableCache(BattleUnit *unit, int costMax);
 public:
 	/// Determines whether the unit is going up a stairs.
 	bool isOnStairs(Position startPosition, Position endPosition) const;
@@ -131,6 +177,10 @@ public:
 	void setUnit(BattleUnit *unit);
 	/// Gets all reachable tiles, based on cost.
 	std::vector<int> findReachable(BattleUnit *unit, const BattleActionCost &cost);
+	/// Forgets cached results of findReachable.
+	void invalidateReachable();
+	/// Marks terrain around position as changed.
+	void invalidateTerrain(Position pos, int radius = 0);
 	/// Gets _totalTUCost; finds out whether we can hike somewhere in this turn or not.
 	int getTotalTUCost() const { return _totalTUCost; }
 	/// Gets the path preview setting.
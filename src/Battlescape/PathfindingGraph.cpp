@@ -0,0 +1,417 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <queue>
+#include "PathfindingGraph.h"
+#include "Pathfinding.h"
+#include "../Savegame/SavedBattleGame.h"
+#include "../Savegame/Tile.h"
+
+namespace OpenXcom
+{
+
+/**
+ * Creates an empty graph, nodes are found on first use.
+ * @param save Pointer to SavedBattleGame object.
+ * @param pathfinding Pathfinding used to get costs of single moves.
+ * @param movementType Movement type of units using this graph.
+ * @param unitSize Size of units using this graph.
+ */
+PathfindingGraph::PathfindingGraph(SavedBattleGame *save, Pathfinding *pathfinding, MovementType movementType, int unitSize) :
+	_save(save), _pathfinding(pathfinding), _movementType(movementType), _unitSize(unitSize), _rebuild(true)
+{
+	_clustersX = (_save->getMapSizeX() + ClusterSize - 1) / ClusterSize;
+	_clustersY = (_save->getMapSizeY() + ClusterSize - 1) / ClusterSize;
+	_clusters.resize(_clustersX * _clustersY);
+}
+
+/**
+ * Deletes the graph.
+ */
+PathfindingGraph::~PathfindingGraph()
+{
+
+}
+
+/**
+ * Gets the cluster that contains a position.
+ * @param pos Position on map.
+ * @return Index of cluster.
+ */
+int PathfindingGraph::getCluster(Position pos) const
+{
+	return (pos.y / ClusterSize) * _clustersX + (pos.x / ClusterSize);
+}
+
+/**
+ * Gets index of position inside of its cluster.
+ * @param cluster Index of cluster.
+ * @param pos Position in that cluster.
+ * @return Index of tile in cluster.
+ */
+int PathfindingGraph::getClusterTileIndex(int cluster, Position pos) const
+{
+	const int x = pos.x - (cluster % _clustersX) * ClusterSize;
+	const int y = pos.y - (cluster / _clustersX) * ClusterSize;
+	return (pos.z * ClusterSize + y) * ClusterSize + x;
+}
+
+/**
+ * Checks if positions are far enough from each other for the graph to be useful.
+ * Paths inside of one or two neighbouring clusters are left to A*.
+ * @param start Start position.
+ * @param end End position.
+ * @return True if graph should be used.
+ */
+bool PathfindingGraph::isFar(Position start, Position end) const
+{
+	return std::abs(start.x / ClusterSize - end.x / ClusterSize) > 1 || std::abs(start.y / ClusterSize - end.y / ClusterSize) > 1;
+}
+
+/**
+ * Adds move from one cluster to the next one to the graph, if unit can do it.
+ * @param unit Unit used to calculate costs.
+ * @param nodeIndex Map from tile index to node index.
+ * @param from Start of move.
+ * @param direction Direction of move.
+ */
+void PathfindingGraph::addLink(BattleUnit *unit, std::vector<int> &nodeIndex, Position from, int direction)
+{
+	Position to;
+	const int cost = _pathfinding->getTUCost(from, direction, &to, unit, 0, false);
+	if (cost >= 255 || !_save->getTile(to) || getCluster(to) == getCluster(from))
+	{
+		return;
+	}
+	int ends[2] = { };
+	const Position positions[2] = { from, to };
+	for (int i = 0; i < 2; ++i)
+	{
+		int &index = nodeIndex[_save->getTileIndex(positions[i])];
+		if (index == -1)
+		{
+			index = (int)_nodes.size();
+			_nodes.push_back(Node());
+			_nodes.back().pos = positions[i];
+			_nodes.back().cluster = getCluster(positions[i]);
+		}
+		ends[i] = index;
+	}
+	_nodes[ends[0]].links.push_back(std::make_pair(ends[1], cost));
+}
+
+/**
+ * Finds all places where units can cross cluster borders.
+ * Each straight part of border that can be crossed gets one node on both sides, in its middle.
+ * Clusters that keep same nodes and have unchanged terrain keep their calculated costs.
+ * @param unit Unit used to calculate costs.
+ */
+void PathfindingGraph::build(BattleUnit *unit)
+{
+	std::vector<Position> oldNodes;
+	oldNodes.reserve(_nodes.size());
+	for (const Node &node : _nodes)
+	{
+		oldNodes.push_back(node.pos);
+	}
+	std::vector<std::vector<int> > oldClusterNodes(_clusters.size());
+	for (size_t c = 0; c < _clusters.size(); ++c)
+	{
+		oldClusterNodes[c].swap(_clusters[c].nodes);
+	}
+
+	_nodes.clear();
+	std::vector<int> nodeIndex(_save->getMapSizeXYZ(), -1);
+	const int sizeX = _save->getMapSizeX() - _unitSize + 1;
+	const int sizeY = _save->getMapSizeY() - _unitSize + 1;
+	const int sizeZ = _save->getMapSizeZ();
+
+	// border moves: east and west across vertical borders, south and north across horizontal ones
+	const int dirForward[2] = { 2, 4 };
+	const int dirBackward[2] = { 6, 0 };
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		const int borders = axis == 0 ? _clustersX : _clustersY;
+		const int length = axis == 0 ? sizeY : sizeX;
+		for (int b = 1; b < borders; ++b)
+		{
+			const int across = b * ClusterSize;
+			if (across >= (axis == 0 ? sizeX : sizeY))
+			{
+				continue;
+			}
+			for (int z = 0; z < sizeZ; ++z)
+			{
+				for (int backward = 0; backward < 2; ++backward)
+				{
+					const int direction = backward ? dirBackward[axis] : dirForward[axis];
+					const int a = backward ? across : across - 1;
+					// each cluster along the border gets its own runs
+					for (int segment = 0; segment < length; segment += ClusterSize)
+					{
+						const int segmentEnd = std::min(segment + ClusterSize, length);
+						int runStart = -1;
+						for (int i = segment; i <= segmentEnd; ++i)
+						{
+							bool open = false;
+							if (i < segmentEnd)
+							{
+								Position to;
+								open = _pathfinding->getTUCost(axis == 0 ? Position(a, i, z) : Position(i, a, z), direction, &to, unit, 0, false) < 255;
+							}
+							if (open && runStart == -1)
+							{
+								runStart = i;
+							}
+							else if (!open && runStart != -1)
+							{
+								const int middle = (runStart + i - 1) / 2;
+								addLink(unit, nodeIndex, axis == 0 ? Position(a, middle, z) : Position(middle, a, z), direction);
+								runStart = -1;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	for (size_t n = 0; n < _nodes.size(); ++n)
+	{
+		_clusters[_nodes[n].cluster].nodes.push_back((int)n);
+	}
+	for (size_t c = 0; c < _clusters.size(); ++c)
+	{
+		Cluster &cluster = _clusters[c];
+		bool same = !cluster.changed && cluster.nodes.size() == oldClusterNodes[c].size();
+		for (size_t i = 0; same && i < cluster.nodes.size(); ++i)
+		{
+			same = _nodes[cluster.nodes[i]].pos == oldNodes[oldClusterNodes[c][i]];
+		}
+		if (!same)
+		{
+			cluster.costs.clear();
+		}
+		cluster.costs.resize(cluster.nodes.size());
+		cluster.changed = false;
+	}
+	_rebuild = false;
+}
+
+/**
+ * Calculates costs of reaching all tiles of a cluster from a position, without leaving the cluster.
+ * @param unit Unit used to calculate costs.
+ * @param cluster Index of cluster.
+ * @param start Start position inside of cluster.
+ * @param costs Output costs, indexed by getClusterTileIndex, INT_MAX for unreachable tiles.
+ */
+void PathfindingGraph::flood(BattleUnit *unit, int cluster, Position start, std::vector<int> &costs)
+{
+	typedef std::pair<int, int> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+	costs.assign(ClusterSize * ClusterSize * _save->getMapSizeZ(), INT_MAX);
+	costs[getClusterTileIndex(cluster, start)] = 0;
+	queue.push(Entry(0, _save->getTileIndex(start)));
+	while (!queue.empty())
+	{
+		const Entry current = queue.top();
+		queue.pop();
+		const Position currentPos = _save->getTileCoords(current.second);
+		if (current.first > costs[getClusterTileIndex(cluster, currentPos)])
+		{
+			continue;
+		}
+		for (int direction = 0; direction < 10; ++direction)
+		{
+			Position nextPos;
+			const int tuCost = _pathfinding->getTUCost(currentPos, direction, &nextPos, unit, 0, false);
+			if (tuCost >= 255 || !_save->getTile(nextPos) || getCluster(nextPos) != cluster)
+			{
+				continue;
+			}
+			int &cost = costs[getClusterTileIndex(cluster, nextPos)];
+			if (current.first + tuCost < cost)
+			{
+				cost = current.first + tuCost;
+				queue.push(Entry(cost, _save->getTileIndex(nextPos)));
+			}
+		}
+	}
+}
+
+/**
+ * Gets costs from a node to all other nodes of its cluster, calculates them if needed.
+ * @param unit Unit used to calculate costs.
+ * @param node Index of node.
+ * @return Costs indexed same as nodes of cluster, INT_MAX when unreachable.
+ */
+const std::vector<int> &PathfindingGraph::getCosts(BattleUnit *unit, int node)
+{
+	Cluster &cluster = _clusters[_nodes[node].cluster];
+	const size_t local = std::find(cluster.nodes.begin(), cluster.nodes.end(), node) - cluster.nodes.begin();
+	std::vector<int> &row = cluster.costs[local];
+	if (row.empty())
+	{
+		std::vector<int> costs;
+		flood(unit, _nodes[node].cluster, _nodes[node].pos, costs);
+		row.reserve(cluster.nodes.size());
+		for (int other : cluster.nodes)
+		{
+			row.push_back(costs[getClusterTileIndex(_nodes[node].cluster, _nodes[other].pos)]);
+		}
+	}
+	return row;
+}
+
+/**
+ * Finds a path on the abstract graph and returns positions where it enters each cluster.
+ * Exact path between these waypoints still needs to be found.
+ * @param unit Unit that is moving.
+ * @param start Start position.
+ * @param end End position.
+ * @param waypoints Output list of positions, last one is the end position.
+ * @return True if path was found.
+ */
+bool PathfindingGraph::findWaypoints(BattleUnit *unit, Position start, Position end, std::vector<Position> &waypoints)
+{
+	if (_rebuild)
+	{
+		build(unit);
+	}
+
+	const int startCluster = getCluster(start);
+	const int endCluster = getCluster(end);
+	if (startCluster == endCluster)
+	{
+		return false;
+	}
+	std::vector<int> startCosts, endCosts;
+	flood(unit, startCluster, start, startCosts);
+	// moves are nearly symmetric, cost from end is good enough to guide the search to it
+	flood(unit, endCluster, end, endCosts);
+
+	const int startNode = (int)_nodes.size();
+	const int endNode = startNode + 1;
+	std::vector<int> cost(_nodes.size() + 2, INT_MAX);
+	std::vector<int> prev(_nodes.size() + 2, -1);
+	std::vector<bool> done(_nodes.size() + 2, false);
+	typedef std::pair<int, int> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+	auto visit = [&](int from, int to, int tuCost)
+	{
+		if (done[to] || cost[from] + tuCost >= cost[to])
+		{
+			return;
+		}
+		cost[to] = cost[from] + tuCost;
+		prev[to] = from;
+		const int guess = to == endNode ? 0 : 4 * Position::distance(_nodes[to].pos, end);
+		queue.push(Entry(cost[to] + guess, to));
+	};
+
+	cost[startNode] = 0;
+	for (int n : _clusters[startCluster].nodes)
+	{
+		const int c = startCosts[getClusterTileIndex(startCluster, _nodes[n].pos)];
+		if (c != INT_MAX)
+		{
+			visit(startNode, n, c);
+		}
+	}
+	while (!queue.empty())
+	{
+		const int current = queue.top().second;
+		queue.pop();
+		if (done[current])
+		{
+			continue;
+		}
+		done[current] = true;
+		if (current == endNode)
+		{
+			break;
+		}
+		const Node &node = _nodes[current];
+		for (const std::pair<int, int> &link : node.links)
+		{
+			visit(current, link.first, link.second);
+		}
+		const std::vector<int> &costs = getCosts(unit, current);
+		const std::vector<int> &clusterNodes = _clusters[node.cluster].nodes;
+		for (size_t i = 0; i < clusterNodes.size(); ++i)
+		{
+			if (costs[i] != INT_MAX && clusterNodes[i] != current)
+			{
+				visit(current, clusterNodes[i], costs[i]);
+			}
+		}
+		if (node.cluster == endCluster)
+		{
+			const int c = endCosts[getClusterTileIndex(endCluster, node.pos)];
+			if (c != INT_MAX)
+			{
+				visit(current, endNode, c);
+			}
+		}
+	}
+	if (!done[endNode])
+	{
+		return false;
+	}
+
+	// keep only positions where path enters a new cluster
+	waypoints.clear();
+	waypoints.push_back(end);
+	for (int n = prev[endNode]; n != startNode && prev[n] != startNode; n = prev[n])
+	{
+		if (_nodes[prev[n]].cluster != _nodes[n].cluster)
+		{
+			waypoints.push_back(_nodes[n].pos);
+		}
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	return true;
+}
+
+/**
+ * Marks terrain around a position as changed, graph will be updated before next use.
+ * @param pos Center of change.
+ * @param radius Radius of change in tiles.
+ */
+void PathfindingGraph::invalidate(Position pos, int radius)
+{
+	// moves into a cluster can start one tile (or one unit size) outside of it
+	const int margin = radius + _unitSize;
+	const int minX = std::max(0, (pos.x - margin) / ClusterSize);
+	const int maxX = std::min(_clustersX - 1, std::max(0, pos.x + margin) / ClusterSize);
+	const int minY = std::max(0, (pos.y - margin) / ClusterSize);
+	const int maxY = std::min(_clustersY - 1, std::max(0, pos.y + margin) / ClusterSize);
+	for (int y = minY; y <= maxY; ++y)
+	{
+		for (int x = minX; x <= maxX; ++x)
+		{
+			_clusters[y * _clustersX + x].changed = true;
+		}
+	}
+	_rebuild = true;
+}
+
+}
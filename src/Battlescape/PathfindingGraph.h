@@ -0,0 +1,99 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <vector>
+#include "Position.h"
+#include "../Mod/MapData.h"
+
+namespace OpenXcom
+{
+
+class SavedBattleGame;
+class Pathfinding;
+class BattleUnit;
+
+/**
+ * Abstract graph of the battlescape used to find long paths.
+ * Map is split in clusters of map block size, nodes of graph are tiles
+ * where a unit can cross from one cluster to the next one.
+ * Costs of moves between nodes of same cluster are calculated when
+ * first needed and kept until terrain of that cluster changes.
+ * Units standing on the map are ignored, exact path is found later by A*.
+ */
+class PathfindingGraph
+{
+public:
+	/// Size of cluster in tiles, same as size of map block.
+	static const int ClusterSize = 10;
+
+private:
+	struct Node
+	{
+		Position pos;
+		int cluster;
+		/// Moves to nodes in other clusters, pairs of node and TU cost.
+		std::vector<std::pair<int, int> > links;
+	};
+	struct Cluster
+	{
+		/// Nodes placed in this cluster.
+		std::vector<int> nodes;
+		/// Costs from each node of cluster to other nodes of cluster, empty row when not calculated yet.
+		std::vector<std::vector<int> > costs;
+		/// Terrain of cluster changed since costs were calculated.
+		bool changed = false;
+	};
+
+	SavedBattleGame *_save;
+	Pathfinding *_pathfinding;
+	MovementType _movementType;
+	int _unitSize;
+	int _clustersX, _clustersY;
+	std::vector<Node> _nodes;
+	std::vector<Cluster> _clusters;
+	bool _rebuild;
+
+	/// Gets the cluster that contains a position.
+	int getCluster(Position pos) const;
+	/// Gets index of position inside of its cluster.
+	int getClusterTileIndex(int cluster, Position pos) const;
+	/// Finds all nodes of the graph.
+	void build(BattleUnit *unit);
+	/// Adds move across cluster border to the graph, if possible.
+	void addLink(BattleUnit *unit, std::vector<int> &nodeIndex, Position from, int direction);
+	/// Calculates costs from a position to all other tiles of its cluster.
+	void flood(BattleUnit *unit, int cluster, Position start, std::vector<int> &costs);
+	/// Gets costs from a node to other nodes of its cluster.
+	const std::vector<int> &getCosts(BattleUnit *unit, int node);
+public:
+	/// Creates an empty graph for given kind of units.
+	PathfindingGraph(SavedBattleGame *save, Pathfinding *pathfinding, MovementType movementType, int unitSize);
+	/// Cleans up the graph.
+	~PathfindingGraph();
+	/// Checks if graph is for given kind of units.
+	bool isFor(MovementType movementType, int unitSize) const { return _movementType == movementType && _unitSize == unitSize; }
+	/// Checks if positions are far enough for the graph to be useful.
+	bool isFar(Position start, Position end) const;
+	/// Finds waypoints of a path, one in each cluster it crosses.
+	bool findWaypoints(BattleUnit *unit, Position start, Position end, std::vector<Position> &waypoints);
+	/// Marks terrain around position as changed.
+	void invalidate(Position pos, int radius);
+};
+
+}
@@ -23,7 +23,6 @@ namespace OpenXcom
 {
 
 class PathfindingOpenSet;
-struct OpenSetEntry;
 
 /**
  * A class that holds pathfinding info for a certain node on the map.
@@ -38,8 +37,8 @@ private:
 	int _prevDir;
 	/// Approximate cost to reach goal position.
 	int _tuGuess;
-	// Invasive field needed by PathfindingOpenSet
-	OpenSetEntry *_openentry;
+	// Invasive field needed by PathfindingOpenSet, place in its heap or -1
+	int _openIndex;
 	friend class PathfindingOpenSet;
 public:
 	/// Creates a new PathfindingNode class.
@@ -61,7 +60,7 @@ public:
 	/// Gets the previous walking direction.
 	int getPrevDir() const;
 	/// Is this node already in a PathfindingOpenSet?
-	bool inOpenSet() const { return (_openentry != 0); }
+	bool inOpenSet() const { return (_openIndex >= 0); }
 	/// Gets the approximate cost to reach the target position.
 	int getTUGuess() const { return _tuGuess; }
 
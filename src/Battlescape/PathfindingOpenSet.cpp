@@ -17,73 +17,150 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <algorithm>
 #include "PathfindingOpenSet.h"
 #include "PathfindingNode.h"
 
 namespace OpenXcom
 {
 
+namespace
+{
+
+/// Number of children of each heap node.
+const int HeapArity = 4;
+
+}
+
+/**
+ * Gets the cost used to order nodes.
+ * @param node Node to check.
+ * @return Cost so far plus approximate cost to reach goal.
+ */
+int PathfindingOpenSet::getCost(const PathfindingNode *node)
+{
+	return node->getTUCost(false) + node->getTUGuess();
+}
+
+/**
+ * Places node in heap and updates its index.
+ * @param node Node to place.
+ * @param index Place in heap.
+ */
+void PathfindingOpenSet::place(PathfindingNode *node, int index)
+{
+	_heap[index] = node;
+	node->_openIndex = index;
+}
+
 /**
- * Cleans up all the entries still in set.
+ * Moves node toward top of heap until its parent is cheaper.
+ * @param index Current place of node.
+ * @return True if node was moved.
  */
-PathfindingOpenSet::~PathfindingOpenSet()
+bool PathfindingOpenSet::siftUp(int index)
 {
-	while (!_queue.empty())
+	PathfindingNode *node = _heap[index];
+	const int cost = getCost(node);
+	const int start = index;
+	while (index > 0)
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		const int parent = (index - 1) / HeapArity;
+		if (getCost(_heap[parent]) <= cost)
+		{
+			break;
+		}
+		place(_heap[parent], index);
+		index = parent;
 	}
+	place(node, index);
+	return index != start;
 }
 
 /**
- * Keeps removing all discarded entries that have come to the top of the queue.
+ * Moves node toward bottom of heap until all its children are more expensive.
+ * @param index Current place of node.
  */
-void PathfindingOpenSet::removeDiscarded()
+void PathfindingOpenSet::siftDown(int index)
 {
-	while (!_queue.empty() && !_queue.top()->_node)
+	PathfindingNode *node = _heap[index];
+	const int cost = getCost(node);
+	const int size = (int)_heap.size();
+	while (true)
 	{
-		OpenSetEntry *entry = _queue.top();
-		_queue.pop();
-		delete entry;
+		const int first = index * HeapArity + 1;
+		if (first >= size)
+		{
+			break;
+		}
+		const int last = std::min(first + HeapArity, size);
+		int best = first;
+		int bestCost = getCost(_heap[first]);
+		for (int child = first + 1; child < last; ++child)
+		{
+			const int childCost = getCost(_heap[child]);
+			if (childCost < bestCost)
+			{
+				best = child;
+				bestCost = childCost;
+			}
+		}
+		if (cost <= bestCost)
+		{
+			break;
+		}
+		place(_heap[best], index);
+		index = best;
 	}
+	place(node, index);
 }
 
 /**
- * Gets the node with the least cost.
- * After this call, the node is no longer in the set. It is an error to call this when the set is empty.
- * @return A pointer to the node which had the least cost.
+ * Removes all nodes from the set. Allocated memory is kept for next use.
+ */
+void PathfindingOpenSet::clear()
+{
+	for (PathfindingNode *node : _heap)
+	{
+		node->_openIndex = -1;
+	}
+	_heap.clear();
+}
+
+/**
+ * Removes the cheapest node from the set.
+ * @return Node to check next.
  */
 PathfindingNode *PathfindingOpenSet::pop()
 {
 	assert(!empty());
-	OpenSetEntry *entry = _queue.top();
-	PathfindingNode *nd = entry->_node;
-	_queue.pop();
-	delete entry;
-	nd->_openentry = 0;
-
-	// Discarded entries might be visible now.
-	removeDiscarded();
+	PathfindingNode *nd = _heap.front();
+	PathfindingNode *last = _heap.back();
+	_heap.pop_back();
+	if (last != nd)
+	{
+		place(last, 0);
+		siftDown(0);
+	}
+	nd->_openIndex = -1;
 	return nd;
 }
 
 /**
- * Places the node in the set.
- * If the node was already in the set, the previous entry is discarded.
- * It is the caller's responsibility to never re-add a node with a worse cost.
- * @param node A pointer to the node to add.
+ * Adds node to the set. If node is already in set, its place is updated to its new cost.
+ * @param node Node to add.
  */
 void PathfindingOpenSet::push(PathfindingNode *node)
 {
-	OpenSetEntry *entry = new OpenSetEntry;
-	entry->_node = node;
-	entry->_cost = node->getTUCost(false) + node->getTUGuess();
-	if (node->_openentry)
-		node->_openentry->_node = 0;
-	node->_openentry = entry;
-	_queue.push(entry);
+	if (node->_openIndex < 0)
+	{
+		_heap.push_back(node);
+		node->_openIndex = (int)_heap.size() - 1;
+	}
+	if (!siftUp(node->_openIndex))
+	{
+		siftDown(node->_openIndex);
+	}
 }
 
-
 }
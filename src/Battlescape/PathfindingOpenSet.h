@@ -17,57 +17,42 @@
  * You should have received a copy of the GNU General Public License
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
-#include <queue>
+#include <vector>
 
 namespace OpenXcom
 {
 
 class PathfindingNode;
 
-struct OpenSetEntry
-{
-	int _cost;
-	PathfindingNode *_node;
-};
-
-/**
- * Helper class to compare entries through pointers.
- */
-class EntryCompare
-{
-public:
-	/**
-	 * Compares entries @a *a and @a *b.
-	 * @param a Pointer to first entry.
-	 * @param b Pointer to second entry.
-	 * @return True if entry @a *b must come before @a *a.
-	 */
-	bool operator()(OpenSetEntry *a, OpenSetEntry *b) const
-	{
-		return b->_cost < a->_cost;
-	}
-};
-
 /**
- * A class that holds references to the nodes to be examined in pathfinding.
+ * Priority queue of pathfinding nodes ordered by cost plus guess.
+ * Indexed 4-ary heap, each node knows its own place in heap,
+ * so updating cost of node already in set don't need new entry.
+ * Storage is kept between uses to avoid allocations.
  */
 class PathfindingOpenSet
 {
 public:
-	/// Cleans up the set and frees allocated memory.
-	~PathfindingOpenSet();
+	/// Removes all nodes from the set, keeps allocated memory.
+	void clear();
 	/// Gets the next node to check.
 	PathfindingNode *pop();
-	/// Adds a node to the set.
+	/// Adds a node to the set or updates its position.
 	void push(PathfindingNode *node);
 	/// Is the set empty?
-	bool empty() const { return _queue.empty(); }
+	bool empty() const { return _heap.empty(); }
 
 private:
-	std::priority_queue<OpenSetEntry*, std::vector<OpenSetEntry*>, EntryCompare> _queue;
-
-	/// Removes reachable discarded entries.
-	void removeDiscarded();
+	std::vector<PathfindingNode*> _heap;
+
+	/// Gets the cost used to order nodes.
+	static int getCost(const PathfindingNode *node);
+	/// Moves node at given index toward top of heap.
+	bool siftUp(int index);
+	/// Moves node at given index toward bottom of heap.
+	void siftDown(int index);
+	/// Places node at given index.
+	void place(PathfindingNode *node, int index);
 };
 
 }
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <assert.h>
+#include <atomic>
 #include <climits>
 #include <set>
 #include "TileEngine.h"
@@ -35,6 +36,7 @@
 #include "../Savegame/HitLog.h"
 #include "../Engine/RNG.h"
 #include "../Engine/GraphSubset.h"
+#include "../Engine/ThreadPool.h"
 #include "BattlescapeState.h"
 #include "../Mod/MapDataSet.h"
 #include "../Mod/Unit.h"
@@ -54,6 +56,24 @@ namespace OpenXcom
 namespace
 {
 
+/**
+ * Last tile used by voxelCheck, kept for each thread separately so line checks can run on worker threads.
+ */
+struct VoxelCheckCache
+{
+	unsigned generation = 0;
+	Position pos = TileEngine::invalid;
+	Tile *tile = nullptr;
+	Tile *tileBelow = nullptr;
+};
+
+thread_local VoxelCheckCache voxelCheckCache;
+/// Changed by voxelCheckFlush, makes caches of all threads invalid.
+std::atomic<unsigned> voxelCheckGeneration{ 1 };
+
+/// Tiles already added by collectTilesInFOV, kept for each thread and cleared after use.
+thread_local std::vector<bool> tilesInFOVSeen;
+
 /**
  * Calculates a line trajectory, using bresenham algorithm in 3D.
  * @param origin Origin.
@@ -195,6 +215,55 @@ void iterateTiles(SavedBattleGame* save, MapSubset gs, TileFunc func)
 	}
 }
 
+/**
+ * Calculate rows of tiles in some area of map, used for loops working directly on TileHotData.
+ * @param save Map data.
+ * @param gs Square subset of map area.
+ * @param func Call back, gets index of first tile in row and length of row.
+ */
+template<typename RowFunc>
+void iterateTileRows(SavedBattleGame* save, MapSubset gs, RowFunc func)
+{
+	const auto totalSizeX = save->getMapSizeX();
+	const auto totalSizeY = save->getMapSizeY();
+	const auto totalSizeZ = save->getMapSizeZ();
+
+	gs = MapSubset::intersection(gs, MapSubset{ totalSizeX, totalSizeY });
+	if (gs)
+	{
+		for (int z = 0; z < totalSizeZ; ++z)
+		{
+			auto rowStart = save->getTileIndex(Position{ gs.beg_x, gs.beg_y, z });
+			for (auto stepsY = gs.size_y(); stepsY != 0; --stepsY, rowStart += totalSizeX)
+			{
+				func(rowStart, gs.size_x());
+			}
+		}
+	}
+}
+
+/**
+ * Reset light of layers from given one up in some area of map.
+ * @param save Map data.
+ * @param gs Square subset of map area.
+ * @param layer First layer to reset.
+ */
+void resetLightMulti(SavedBattleGame* save, MapSubset gs, LightLayers layer)
+{
+	auto& hot = save->getTileHotData();
+	iterateTileRows(
+		save,
+		gs,
+		[&](int index, int size)
+		{
+			for (int l = layer; l < LL_MAX; ++l)
+			{
+				std::fill_n(hot.light[l].begin() + index, size, 0);
+			}
+		}
+	);
+}
+
 /**
  * Generate square subset of map using position and radius.
  * @param position Starting position.
@@ -228,14 +297,14 @@ constexpr Position TileEngine::voxelTileCenter;
  * @param maxDarknessToSeeUnits Threshold of darkness for LoS calculation.
  */
 TileEngine::TileEngine(SavedBattleGame *save, Mod *mod) :
-	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true), _cacheTile(0), _cacheTileBelow(0),
+	_save(save), _voxelData(mod->getVoxelData()), _inventorySlotGround(mod->getInventoryGround()), _personalLighting(true),
 	_maxViewDistance(mod->getMaxViewDistance()), _maxViewDistanceSq(_maxViewDistance * _maxViewDistance),
 	_maxVoxelViewDistance(_maxViewDistance * 16), _maxDarknessToSeeUnits(mod->getMaxDarknessToSeeUnits()),
 	_maxStaticLightDistance(mod->getMaxStaticLightDistance()), _maxDynamicLightDistance(mod->getMaxDynamicLightDistance()),
 	_enhancedLighting(mod->getEnhancedLighting())
 {
 	_blockVisibility.resize(save->getMapSizeXYZ());
-	_cacheTilePos = invalid;
+	voxelCheckFlush();
 }
 
 /**
@@ -479,31 +548,36 @@ void TileEngine::calculateLighting(LightLayers layer, Position position, int eve
 		);
 	}
 
-	if (layer <= LL_FIRE)
-	{
-		iterateTiles(
-			_save,
-			gsStatic,
-			[&](Tile* tile)
+	// map is split in stripes along x, light sources only write to tiles of stripe they are calculated for
+	// and tiles keep the strongest light, so stripes can be done on different threads with same final result.
+	const int mapSizeX = _save->getMapSizeX();
+	const int stripes = ThreadPool::getThreadCount() > 1 ? std::min(mapSizeX, 2 * ThreadPool::getThreadCount()) : 1;
+
+	ThreadPool::parallelFor(stripes,
+		[&](int i)
+		{
+			const auto stripe = MapSubset{ std::make_pair(mapSizeX * i / stripes, mapSizeX * (i + 1) / stripes), std::make_pair(0, (int)_save->getMapSizeY()) };
+			const auto stripeStatic = MapSubset::intersection(gsStatic, stripe);
+			const auto stripeDynamic = MapSubset::intersection(gsDynamic, stripe);
+
+			if (!stripeStatic && !stripeDynamic)
 			{
-				tile->resetLightMulti(layer);
+				return;
 			}
-		);
-	}
 
-	iterateTiles(
-		_save,
-		gsDynamic,
-		[&](Tile* tile)
-		{
-			tile->resetLightMulti(std::max(layer, LL_ITEMS));
+			if (layer <= LL_FIRE)
+			{
+				resetLightMulti(_save, stripeStatic, layer);
+			}
+
+			resetLightMulti(_save, stripeDynamic, std::max(layer, LL_ITEMS));
+
+			if (layer <= LL_AMBIENT && stripeStatic) calculateSunShading(stripeStatic);
+			if (layer <= LL_FIRE && stripeStatic) calculateTerrainBackground(stripeStatic);
+			if (layer <= LL_ITEMS && stripeDynamic) calculateTerrainItems(stripeDynamic);
+			if (layer <= LL_UNITS && stripeDynamic) calculateUnitLighting(stripeDynamic);
 		}
 	);
-
-	if (layer <= LL_AMBIENT) calculateSunShading(gsStatic);
-	if (layer <= LL_FIRE) calculateTerrainBackground(gsStatic);
-	if (layer <= LL_ITEMS) calculateTerrainItems(gsDynamic);
-	if (layer <= LL_UNITS) calculateUnitLighting(gsDynamic);
 }
 
 /**
@@ -714,6 +788,50 @@ bool TileEngine::setupEventVisibilitySector(const Position &observerPos, const P
 	}
 }
 
+/**
+ * Stores in the unit the 2d bounding box of its current view cone, as swept by calculateTilesInFOV and checkViewSector.
+ * Later events outside of this area can't change what the unit sees, so calculateFOV can skip it.
+ * @param unit The observer.
+ */
+void TileEngine::setupUnitViewArea(BattleUnit *unit)
+{
+	int direction;
+	if (Options::strafe && (unit->getTurretType() > -1))
+	{
+		direction = unit->getTurretDirection();
+	}
+	else
+	{
+		direction = unit->getDirection();
+	}
+	const bool swap = (direction == 0 || direction == 4);
+	const int signX[8] = { +1, +1, +1, +1, -1, -1, -1, -1 };
+	const int signY[8] = { -1, -1, -1, +1, +1, +1, -1, -1 };
+	const int dist = getMaxViewDistance();
+	// same sweep as calculateTilesInFOV: x along view direction, y across it
+	const int yMin = (direction & 1) ? 0 : -dist;
+	const int yMax = dist;
+
+	Position posSelf = unit->getPosition();
+	Position areaMin = posSelf, areaMax = posSelf;
+	for (int x : { 0, dist })
+	{
+		for (int y : { yMin, yMax })
+		{
+			Position corner = posSelf + Position(signX[direction] * (swap ? y : x), signY[direction] * (swap ? x : y), 0);
+			areaMin.x = std::min(areaMin.x, corner.x);
+			areaMin.y = std::min(areaMin.y, corner.y);
+			areaMax.x = std::max(areaMax.x, corner.x);
+			areaMax.y = std::max(areaMax.y, corner.y);
+		}
+	}
+	// large units see from each of their tiles, and seen tiles reveal walls on the east and south
+	const int size = unit->getArmor()->getSize();
+	areaMin -= Position(size, size, 0);
+	areaMax += Position(size, size, 0);
+	unit->setViewArea(areaMin, areaMax);
+}
+
 /**
  * Checks whether toCheck is within a previously setup eventVisibilitySector. See setupEventVisibilitySector(...).
  * May be used to rapidly reduce the search space when updating unit and tile visibility.
@@ -758,6 +876,7 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 	{
 		//Asked to do a full check. Or the event is overlapping our tile. Better check everything.
 		unit->clearVisibleUnits();
+		setupUnitViewArea(unit);
 	}
 
 	//Loop through all units specified and figure out which ones we can actually see.
@@ -825,50 +944,34 @@ bool TileEngine::calculateUnitsInFOV(BattleUnit* unit, const Position eventPos,
 }
 
 /**
-* Calculates line of sight of tiles for a player controlled soldier.
-* If supplied with an event position differing from the soldier's position, it will only
-* calculate tiles within a narrow arc.
+* Collects tiles in line of sight of a unit, without changing any visibility state.
+* Only reads terrain cache, so it can be run for many units at once on worker threads.
 * @param unit Unit to check line of sight of.
-* @param eventPos The centre of the event which necessitated the FOV update. Used to optimize which tiles to update.
-* @param eventRadius The radius of a circle able to fully encompass the event, in tiles. Hence: 1 for a single tile event.
+* @param distanceSqrMin Only tiles at least this far (squared) from the unit are checked.
+* @param narrowArc True to limit tiles to the arc set up by setupEventVisibilitySector.
+* @param tiles Output list of visible tiles, each tile only once, in order of discovery.
 */
-void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos, const int eventRadius)
+void TileEngine::collectTilesInFOV(BattleUnit *unit, const int distanceSqrMin, const bool narrowArc, std::vector<Position> &tiles)
 {
-	bool useTurretDirection = false;
-	bool skipNarrowArcTest = false;
 	int direction;
 	if (Options::strafe && (unit->getTurretType() > -1)) {
 		direction = unit->getTurretDirection();
-		useTurretDirection = true;
 	}
 	else
 	{
 		direction = unit->getDirection();
 	}
-	if (unit->getFaction() != FACTION_PLAYER || (eventRadius == 1 && !unit->checkViewSector(eventPos, useTurretDirection)))
-	{
-		//The event wasn't meant for us and/or visible for us.
-		return;
-	}
-	else if (unit->isOut())
-	{
-		unit->clearVisibleTiles();
-		return;
-	}
 	Position posSelf = unit->getPosition();
-	if (setupEventVisibilitySector(posSelf, eventPos, eventRadius))
-	{
-		//Asked to do a full check. Or unit within event. Should update all.
-		unit->clearVisibleTiles();
-		skipNarrowArcTest = true;
-	}
-
-	//Only recalculate bresenham lines to tiles that are at the event or further away.
-	const int distanceSqrMin = skipNarrowArcTest ? 0 : std::max(Position::distance2dSq(posSelf, eventPos) - eventRadius * eventRadius, 0);
 
 	//Variables for finding the tiles to test based on the view direction.
 	Position posTest;
 	std::vector<Position> _trajectory;
+	std::vector<bool> &seen = tilesInFOVSeen;
+	if (seen.size() < (size_t)_save->getMapSizeXYZ())
+	{
+		seen.resize(_save->getMapSizeXYZ(), false);
+	}
+	const size_t firstNew = tiles.size();
 	bool swap = (direction == 0 || direction == 4);
 	const int signX[8] = { +1, +1, +1, +1, -1, -1, -1, -1 };
 	const int signY[8] = { -1, -1, -1, +1, +1, +1, -1, -1 };
@@ -903,7 +1006,7 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 				posTest.x = posSelf.x + signX[direction] * (swap ? y : x);
 				posTest.y = posSelf.y + signY[direction] * (swap ? x : y);
 				//Only continue if the column of tiles at (x,y) is within the narrow arc of interest (if enabled)
-				if (inEventVisibilitySector(posTest))
+				if (!narrowArc || inEventVisibilitySector(posTest))
 				{
 					for (int z = 0; z < _save->getMapSizeZ(); z++)
 					{
@@ -929,20 +1032,13 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 									//Reveal all tiles along line of vision. Note: needed due to width of bresenham stroke.
 									for (std::vector<Position>::iterator i = _trajectory.begin(); i != _trajectory.end(); ++i)
 									{
-										Position posVisited = (*i);
-										//Add tiles to the visible list only once. BUT we still need to calculate the whole trajectory as
+										//Add tiles to the list only once. BUT we still need to calculate the whole trajectory as
 										// this bresenham line's period might be different from the one that originally revealed the tile.
-										if (!unit->hasVisibleTile(_save->getTile(posVisited)))
+										const int index = _save->getTileIndex(*i);
+										if (!seen[index])
 										{
-											unit->addToVisibleTiles(_save->getTile(posVisited));
-											_save->getTile(posVisited)->setVisible(+1);
-											_save->getTile(posVisited)->setDiscovered(true, O_FLOOR);
-
-											// walls to the east or south of a visible tile, we see that too
-											Tile* t = _save->getTile(Position(posVisited.x + 1, posVisited.y, posVisited.z));
-											if (t) t->setDiscovered(true, O_WESTWALL);
-											t = _save->getTile(Position(posVisited.x, posVisited.y + 1, posVisited.z));
-											if (t) t->setDiscovered(true, O_NORTHWALL);
+											seen[index] = true;
+											tiles.push_back(*i);
 										}
 									}
 								}
@@ -953,6 +1049,75 @@ void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos,
 			}
 		}
 	}
+
+	// only clear what was set, so next call don't need to touch whole map
+	for (size_t i = firstNew; i < tiles.size(); ++i)
+	{
+		seen[_save->getTileIndex(tiles[i])] = false;
+	}
+}
+
+/**
+* Calculates line of sight of tiles for a player controlled soldier.
+* If supplied with an event position differing from the soldier's position, it will only
+* calculate tiles within a narrow arc.
+* @param unit Unit to check line of sight of.
+* @param eventPos The centre of the event which necessitated the FOV update. Used to optimize which tiles to update.
+* @param eventRadius The radius of a circle able to fully encompass the event, in tiles. Hence: 1 for a single tile event.
+* @param tilesInFOV Tiles already collected by collectTilesInFOV for a full check, or null to collect them here.
+*/
+void TileEngine::calculateTilesInFOV(BattleUnit *unit, const Position eventPos, const int eventRadius, const std::vector<Position> *tilesInFOV)
+{
+	bool useTurretDirection = false;
+	bool skipNarrowArcTest = false;
+	if (Options::strafe && (unit->getTurretType() > -1)) {
+		useTurretDirection = true;
+	}
+	if (unit->getFaction() != FACTION_PLAYER || (eventRadius == 1 && !unit->checkViewSector(eventPos, useTurretDirection)))
+	{
+		//The event wasn't meant for us and/or visible for us.
+		return;
+	}
+	else if (unit->isOut())
+	{
+		unit->clearVisibleTiles();
+		return;
+	}
+	Position posSelf = unit->getPosition();
+	if (setupEventVisibilitySector(posSelf, eventPos, eventRadius))
+	{
+		//Asked to do a full check. Or unit within event. Should update all.
+		unit->clearVisibleTiles();
+		skipNarrowArcTest = true;
+		setupUnitViewArea(unit);
+	}
+
+	//Only recalculate bresenham lines to tiles that are at the event or further away.
+	const int distanceSqrMin = skipNarrowArcTest ? 0 : std::max(Position::distance2dSq(posSelf, eventPos) - eventRadius * eventRadius, 0);
+
+	std::vector<Position> tiles;
+	if (!tilesInFOV)
+	{
+		collectTilesInFOV(unit, distanceSqrMin, !skipNarrowArcTest, tiles);
+		tilesInFOV = &tiles;
+	}
+
+	for (const Position &posVisited : *tilesInFOV)
+	{
+		Tile *tile = _save->getTile(posVisited);
+		if (!unit->hasVisibleTile(tile))
+		{
+			unit->addToVisibleTiles(tile);
+			tile->setVisible(+1);
+			tile->setDiscovered(true, O_FLOOR);
+
+			// walls to the east or south of a visible tile, we see that too
+			Tile* t = _save->getTile(Position(posVisited.x + 1, posVisited.y, posVisited.z));
+			if (t) t->setDiscovered(true, O_WESTWALL);
+			t = _save->getTile(Position(posVisited.x, posVisited.y + 1, posVisited.z));
+			if (t) t->setDiscovered(true, O_NORTHWALL);
+		}
+	}
 }
 
 /**
@@ -1705,7 +1870,8 @@ void TileEngine::calculateFOV(Position position, int eventRadius, const bool upd
 	}
 	for (std::vector<BattleUnit*>::iterator i = _save->getUnits()->begin(); i != _save->getUnits()->end(); ++i)
 	{
-		if (Position::distance2dSq(position, (*i)->getPosition()) <= updateRadius) //could this unit have observed the event?
+		//could this unit have observed the event? units looking away from it keep their current visibility
+		if (Position::distance2dSq(position, (*i)->getPosition()) <= updateRadius && (*i)->isViewAreaAffected(position, eventRadius))
 		{
 			if (updateTiles)
 			{
@@ -2471,6 +2637,10 @@ void TileEngine::hit(BattleActionAttack attack, Position center, int power, cons
 			{
 				_save->addDestroyedObjective();
 			}
+			if (terrainChanged)
+			{
+				_save->getPathfinding()->invalidateTerrain(tile->getPosition());
+			}
 		}
 	}
 	else if (part == V_UNIT)
@@ -2827,6 +2997,7 @@ bool TileEngine::detonate(Tile* tile, int explosive)
 		// add some smoke if tile was destroyed and not set on fire
 		if (destroyed)
 		{
+			_save->getPathfinding()->invalidateTerrain(tiles[i]->getPosition());
 			if (tiles[i]->getFire() && !tiles[i]->getMapData(O_FLOOR) && !tiles[i]->getMapData(O_OBJECT))
 			{
 				tiles[i]->setFire(0);// if the object set the floor on fire, and the floor was subsequently destroyed, the fire needs to go out
@@ -3393,6 +3564,8 @@ int TileEngine::unitOpensDoor(BattleUnit *unit, bool rClick, int dir)
 
 	if (door == 0 || door == 1)
 	{
+		// tiles were already changed by openDoor, even if the TU checks below fail
+		_save->getPathfinding()->invalidateTerrain(doorCentre, doorsOpened);
 		if (_save->getBattleGame()->checkReservedTU(unit, TUCost, 0))
 		{
 			if (unit->spendTimeUnits(TUCost))
@@ -3479,7 +3652,11 @@ int TileEngine::closeUfoDoors()
 				continue;
 			}
 		}
-		doorsclosed += _save->getTile(i)->closeUfoDoor();
+		if (_save->getTile(i)->closeUfoDoor())
+		{
+			_save->getPathfinding()->invalidateTerrain(_save->getTileCoords(i));
+			++doorsclosed;
+		}
 	}
 
 	return doorsclosed;
@@ -3764,10 +3941,12 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 	}
 	Position pos = voxel.toTile();
 	Tile *tile, *tileBelow;
-	if (_cacheTilePos == pos)
+	VoxelCheckCache &cache = voxelCheckCache;
+	const unsigned generation = voxelCheckGeneration.load(std::memory_order_relaxed);
+	if (cache.pos == pos && cache.generation == generation)
 	{
-		tile = _cacheTile;
-		tileBelow = _cacheTileBelow;
+		tile = cache.tile;
+		tileBelow = cache.tileBelow;
 	}
 	else
 	{
@@ -3777,9 +3956,10 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 			return V_OUTOFBOUNDS; //not even cache
 		}
 		tileBelow = _save->getBelowTile(tile);
-		_cacheTilePos = pos;
-		_cacheTile = tile;
-		_cacheTileBelow = tileBelow;
+		cache.generation = generation;
+		cache.pos = pos;
+		cache.tile = tile;
+		cache.tileBelow = tileBelow;
  	}
 
 	if (tile->isVoid() && tile->getUnit() == 0 && (!tileBelow || tileBelow->getUnit() == 0))
@@ -3796,18 +3976,18 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 	}
 
 	// first we check terrain voxel data, not to allow 2x2 units stick through walls
-	for (int i = V_FLOOR; i <= V_OBJECT; ++i)
+	const int layer = (voxel.z%24)/2;
+	if (tile->getVoxelLayers() & (1 << layer))
 	{
-		TilePart tp = (TilePart)i;
-		MapData *mp = tile->getMapData(tp);
-		if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
-			continue;
-		if (mp != 0)
+		const int x = voxel.x%16;
+		const int y = voxel.y%16;
+		for (int i = V_FLOOR; i <= V_OBJECT; ++i)
 		{
-			int x = 15 - voxel.x%16;
-			int y = voxel.y%16;
-			int idx = (mp->getLoftID((voxel.z%24)/2)*16) + y;
-			if (_voxelData->at(idx) & (1 << x))
+			TilePart tp = (TilePart)i;
+			MapData *mp = tile->getMapData(tp);
+			if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && tile->isUfoDoorOpen(tp))
+				continue;
+			if (mp != 0 && mp->isVoxelSolid(x, y, layer))
 			{
 				return (VoxelType)i;
 			}
@@ -3858,9 +4038,7 @@ VoxelType TileEngine::voxelCheck(Position voxel, BattleUnit *excludeUnit, bool e
 
 void TileEngine::voxelCheckFlush()
 {
-	_cacheTilePos = invalid;
-	_cacheTile = 0;
-	_cacheTileBelow = 0;
+	++voxelCheckGeneration;
 }
 
 /**
@@ -4850,11 +5028,31 @@ bool TileEngine::validateThrow(BattleAction &action, Position originVoxel, Posit
  */
 void TileEngine::recalculateFOV()
 {
-	for (std::vector<BattleUnit*>::iterator bu = _save->getUnits()->begin(); bu != _save->getUnits()->end(); ++bu)
+	std::vector<BattleUnit*> *units = _save->getUnits();
+	std::vector<std::vector<Position>> tilesInFOV(units->size());
+	std::vector<char> collected(units->size(), false);
+
+	// tracing view lines only reads terrain, each unit can be done on a different thread
+	ThreadPool::parallelFor((int)units->size(),
+		[&](int i)
+		{
+			BattleUnit *unit = (*units)[i];
+			if (unit->getTile() != 0 && unit->getFaction() == FACTION_PLAYER && !unit->isOut())
+			{
+				collectTilesInFOV(unit, 0, false, tilesInFOV[i]);
+				collected[i] = true;
+			}
+		}
+	);
+
+	// apply results in unit order, same as calculating them one by one
+	for (size_t i = 0; i < units->size(); ++i)
 	{
-		if ((*bu)->getTile() != 0)
+		BattleUnit *unit = (*units)[i];
+		if (unit->getTile() != 0)
 		{
-			calculateFOV(*bu);
+			calculateTilesInFOV(unit, invalid, 0, collected[i] ? &tilesInFOV[i] : nullptr);
+			calculateUnitsInFOV(unit);
 		}
 	}
 }
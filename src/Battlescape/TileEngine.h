@@ -97,9 +97,6 @@ private:
 	RuleInventory *_inventorySlotGround;
 	constexpr static int heightFromCenter[11] = {0,-2,+2,-4,+4,-6,+6,-8,+8,-12,+12};
 	bool _personalLighting;
-	Tile *_cacheTile;
-	Tile *_cacheTileBelow;
-	Position _cacheTilePos;
 	const int _maxViewDistance;        // 20 tiles by default
 	const int _maxViewDistanceSq;      // 20 * 20
 	const int _maxVoxelViewDistance;   // maxViewDistance * 16
@@ -131,7 +128,11 @@ private:
 	int getMaxDarknessToSeeUnits() const { return _maxDarknessToSeeUnits; }
 
 	bool setupEventVisibilitySector(const Position &observerPos, const Position &eventPos, const int &eventRadius);
+	/// Stores the area covered by the view cone of a unit.
+	void setupUnitViewArea(BattleUnit *unit);
 	inline bool inEventVisibilitySector(const Position &toCheck) const;
+	/// Collects tiles in line of sight of a unit, without changing visibility.
+	void collectTilesInFOV(BattleUnit *unit, const int distanceSqrMin, const bool narrowArc, std::vector<Position> &tiles);
 
 	/// Calculates sun shading of the whole map.
 	void calculateSunShading(MapSubset gs);
@@ -156,7 +157,7 @@ public:
 	/// Cleans up the TileEngine.
 	~TileEngine();
 	/// Calculates visible tiles within the field of view. Supply an eventPosition to do an update limited to a small slice of the view sector.
-	void calculateTilesInFOV(BattleUnit *unit, const Position eventPos = invalid, const int eventRadius = 0);
+	void calculateTilesInFOV(BattleUnit *unit, const Position eventPos = invalid, const int eventRadius = 0, const std::vector<Position> *tilesInFOV = nullptr);
 	/// Calculates visible units within the field of view. Supply an eventPosition to do an update limited to a small slice of the view sector.
 	bool calculateUnitsInFOV(BattleUnit* unit, const Position eventPos = invalid, const int eventRadius = 0);
 	/// Calculates the field of view from a units view point.
@@ -70,6 +70,8 @@
 #include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -1033,6 +1035,78 @@ std::unique_ptr<std::istream> readFile(const std::string& filename) {
 	return std::unique_ptr<std::istream>(new std::istringstream(datastr));
 }
 
+/**
+ * Maps the whole file to memory, so it can be read without copying it.
+ * Empty files and anything that is not a regular file are not mapped.
+ * @param filename Full path to file.
+ * @param size Set to size of file on success.
+ * @return Pointer to file data or null if the file can't be mapped.
+ */
+void *mapFile(const std::string& filename, size_t *size)
+{
+#ifdef _WIN32
+	auto pathW = pathToWindows(filename);
+	HANDLE file = CreateFileW(pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return nullptr;
+	}
+	void *data = nullptr;
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 && (unsigned long long)fileSize.QuadPart <= SIZE_MAX)
+	{
+		HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mapping)
+		{
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	if (data)
+	{
+		*size = (size_t)fileSize.QuadPart;
+	}
+	return data;
+#else
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return nullptr;
+	}
+	void *data = nullptr;
+	struct stat info;
+	if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+	{
+		data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			data = nullptr;
+		}
+		else
+		{
+			*size = info.st_size;
+		}
+	}
+	close(fd);
+	return data;
+#endif
+}
+
+/**
+ * Releases file mapping created by mapFile.
+ * @param data Pointer returned by mapFile.
+ * @param size Size of file.
+ */
+void unmapFile(void *data, size_t size)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif
+}
+
 /**
  * Gets an istream to a file's bytes at least up to and including first "\n---" sequence.
  * To be used only for savegames.
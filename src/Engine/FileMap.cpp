@@ -41,6 +41,9 @@
 #include <istream>
 #include <unordered_map>
 #include <unordered_set>
+#include <climits>
+#include <map>
+#include <mutex>
 
 #include "FileMap.h"
 #include "Unicode.h"
@@ -48,6 +51,7 @@
 #include "CrossPlatform.h"
 #include "Options.h"
 #include "Exception.h"
+#include "LoadProfiler.h"
 
 #define MINIZ_NO_STDIO
 #include "../../libs/miniz/miniz.h"
@@ -64,7 +68,93 @@ int mzops_close(struct SDL_RWops *context) {
 	}
 	return 0;
 }
+/* files mapped to memory, views into them (like stored zip entries) keep mapping alive until closed */
+struct MappedFile {
+	size_t size;
+	int refs;
+};
+static std::mutex MappedFilesMutex;
+static std::map<const Uint8 *, MappedFile> MappedFiles;
+
+static void mappedAcquire(const Uint8 *ptr) {
+	std::lock_guard<std::mutex> lock(MappedFilesMutex);
+	auto i = MappedFiles.upper_bound(ptr);
+	if (i != MappedFiles.begin()) {
+		--i;
+		++i->second.refs;
+	}
+}
+
+static void mappedRelease(const Uint8 *ptr) {
+	std::lock_guard<std::mutex> lock(MappedFilesMutex);
+	auto i = MappedFiles.upper_bound(ptr);
+	if (i != MappedFiles.begin()) {
+		--i;
+		if (--i->second.refs == 0) {
+			OpenXcom::CrossPlatform::unmapFile((void *)i->first, i->second.size);
+			MappedFiles.erase(i);
+		}
+	}
+}
+
+int mappedops_close(struct SDL_RWops *context) {
+	if (context) {
+		if (context->hidden.mem.base) {
+			mappedRelease(context->hidden.mem.base);
+		}
+		SDL_FreeRW(context);
+	}
+	return 0;
+}
+
+/* wraps whole file mapped to memory in ConstMem RWops, NULL if file can't be mapped */
+SDL_RWops *SDL_RWFromMappedFile(const char *path) {
+	size_t size = 0;
+	void *data = OpenXcom::CrossPlatform::mapFile(path, &size);
+	if (data == NULL || size > INT_MAX) {
+		if (data) { OpenXcom::CrossPlatform::unmapFile(data, size); }
+		return NULL;
+	}
+	{
+		std::lock_guard<std::mutex> lock(MappedFilesMutex);
+		MappedFiles[(const Uint8 *)data] = MappedFile{ size, 1 };
+	}
+	SDL_RWops *rv = SDL_RWFromConstMem(data, (int)size);
+	if (rv == NULL) {
+		mappedRelease((const Uint8 *)data);
+		return NULL;
+	}
+	rv->close = mappedops_close;
+	return rv;
+}
+
+/* stored entries of zip mapped to memory are used in place, without any copy */
+static SDL_RWops *SDL_RWFromMZStored(mz_zip_archive *zip, mz_uint file_index) {
+	SDL_RWops *archive = (SDL_RWops *)zip->m_pIO_opaque;
+	if (!archive || archive->close != mappedops_close) { return NULL; }
+	mz_zip_archive_file_stat stat;
+	if (!mz_zip_reader_file_stat(zip, file_index, &stat)) { return NULL; }
+	if (stat.m_method != 0 || stat.m_is_encrypted || stat.m_comp_size != stat.m_uncomp_size || stat.m_comp_size == 0 || stat.m_comp_size > INT_MAX) { return NULL; }
+	const Uint8 *base = archive->hidden.mem.base;
+	mz_uint64 total = archive->hidden.mem.stop - base;
+	mz_uint64 ofs = stat.m_local_header_ofs;
+	if (ofs + 30 > total) { return NULL; }
+	const Uint8 *header = base + ofs;
+	if (header[0] != 'P' || header[1] != 'K' || header[2] != 3 || header[3] != 4) { return NULL; }
+	mz_uint64 dataOfs = ofs + 30 + (header[26] | (header[27] << 8)) + (header[28] | (header[29] << 8));
+	if (dataOfs + stat.m_comp_size > total) { return NULL; }
+	SDL_RWops *rv = SDL_RWFromConstMem(base + dataOfs, (int)stat.m_comp_size);
+	if (rv == NULL) { return NULL; }
+	mappedAcquire(base + dataOfs);
+	rv->close = mappedops_close;
+	return rv;
+}
+
 SDL_RWops *SDL_RWFromMZ(mz_zip_archive *zip, mz_uint file_index) {
+	SDL_RWops *stored = SDL_RWFromMZStored(zip, file_index);
+	if (stored) {
+		return stored;
+	}
 	size_t size;
 	void *data = mz_zip_reader_extract_to_heap(zip, file_index, &size, 0);
 	if (data == NULL) {
@@ -72,6 +162,10 @@ SDL_RWops *SDL_RWFromMZ(mz_zip_archive *zip, mz_uint file_index) {
 		return NULL;
 	}
 	SDL_RWops *rv = SDL_RWFromConstMem(data, size);
+	if (rv == NULL) {
+		mz_free(data);
+		return NULL;
+	}
 	rv->close = mzops_close;
 	return rv;
 }
@@ -176,6 +270,64 @@ namespace OpenXcom
 namespace FileMap
 {
 
+/**
+ * Read only stream buffer using memory of ConstMem RWops directly.
+ * Takes ownership of RWops.
+ */
+class RWopsMemoryBuf : public std::streambuf
+{
+	SDL_RWops *_rwops;
+
+public:
+	RWopsMemoryBuf(SDL_RWops *rwops) : _rwops(rwops)
+	{
+		char *base = (char *)rwops->hidden.mem.base;
+		setg(base, base, (char *)rwops->hidden.mem.stop);
+	}
+	~RWopsMemoryBuf()
+	{
+		SDL_RWclose(_rwops);
+	}
+
+protected:
+	pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+	{
+		off_type pos = off;
+		if (dir == std::ios_base::cur)
+		{
+			pos += gptr() - eback();
+		}
+		else if (dir == std::ios_base::end)
+		{
+			pos += egptr() - eback();
+		}
+		return seekpos(pos, which);
+	}
+	pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+	{
+		if (!(which & std::ios_base::in) || pos < 0 || pos > egptr() - eback())
+		{
+			return pos_type(off_type(-1));
+		}
+		setg(eback(), eback() + (off_type)pos, egptr());
+		return pos;
+	}
+};
+
+/**
+ * Input stream over file data, without copying it.
+ */
+class RWopsMemoryStream : public std::istream
+{
+	RWopsMemoryBuf _buf;
+
+public:
+	RWopsMemoryStream(SDL_RWops *rwops) : std::istream(nullptr), _buf(rwops)
+	{
+		rdbuf(&_buf);
+	}
+};
+
 static inline std::string concatPaths(const std::string& basePath, const std::string& relativePath)
 {
 	if(basePath.size() == 0) throw Exception("Need correct basePath");
@@ -213,9 +365,13 @@ SDL_RWops *FileRecord::getRWops() const
 	if (zip != NULL) {
 		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
 	} else {
-		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
+		rv = SDL_RWFromMappedFile(fullpath.c_str());
+		if (!rv) {
+			rv = SDL_RWFromFile(fullpath.c_str(), "rb");
+		}
 	}
 	if (!rv) { Log(LOG_ERROR) << "FileRecord::getRWops(): err=" << SDL_GetError(); }
+	else if (LoadProfiler::isEnabled()) { LoadProfiler::addBytesRead(SDL_RWsize(rv)); }
 	return rv;
 }
 
@@ -226,17 +382,16 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 	{
 		rv = SDL_RWFromMZ((mz_zip_archive *)zip, findex);
 	}
-	else
+	else if (!(rv = SDL_RWFromMappedFile(fullpath.c_str())))
 	{
 		rv = SDL_RWFromFile(fullpath.c_str(), "rb");
 		if (rv)
 		{
 			size_t size = 0;
 			auto data = SDL_LoadFile_RW(rv, &size, SDL_TRUE);
-			if (data)
+			rv = data ? SDL_RWFromConstMem(data, size) : nullptr;
+			if (rv)
 			{
-				rv = SDL_RWFromConstMem(data, size);
-
 				//close callback
 				rv->close = [](struct SDL_RWops *context)
 				{
@@ -252,34 +407,61 @@ SDL_RWops *FileRecord::getRWopsReadAll() const
 					return 0;
 				};
 			}
-			else
+			else if (data)
 			{
-				rv = nullptr;
+				SDL_free(data);
 			}
 		}
 	}
 	if (!rv) { Log(LOG_ERROR) << "FileRecord::getRWopsReadAll(): err=" << SDL_GetError(); }
+	else if (LoadProfiler::isEnabled()) { LoadProfiler::addBytesRead(SDL_RWsize(rv)); }
 	return rv;
 }
 
+/**
+ * Checks if file has no content, RWops can't be made for empty memory.
+ * @param rec File record.
+ * @return True if file exists and is empty.
+ */
+static bool isEmptyFile(const FileRecord &rec)
+{
+	if (rec.zip != NULL)
+	{
+		mz_zip_archive_file_stat stat;
+		return mz_zip_reader_file_stat((mz_zip_archive *)rec.zip, (mz_uint)rec.findex, &stat) && stat.m_uncomp_size == 0;
+	}
+	SDL_RWops *rw = SDL_RWFromFile(rec.fullpath.c_str(), "rb");
+	if (rw == NULL)
+	{
+		return false;
+	}
+	bool empty = SDL_RWsize(rw) == 0;
+	SDL_RWclose(rw);
+	return empty;
+}
+
 std::unique_ptr<std::istream> FileRecord::getIStream() const
 {
-	if (zip != NULL) {
-		size_t size;
-		void *data = mz_zip_reader_extract_to_heap((mz_zip_archive *)zip, findex, &size, 0);
-		if (data == NULL) {
-			auto err = "FileRecord::getIStream(): failed to decompress " + fullpath + ": ";
-			err += mz_zip_get_error_string(mz_zip_get_last_error((mz_zip_archive *)zip));
-			Log(LOG_FATAL) << err;
-			throw Exception(err);
-		}
-		std::string a_string((char *)data, size);
-		auto rv = new std::stringstream(a_string);
-		mz_free(data);
-		return std::unique_ptr<std::istream>(rv);
-	} else {
-		return CrossPlatform::readFile(fullpath);
+	// empty files can't be mapped, so only check them when mapping fails
+	SDL_RWops *rw = zip == NULL ? SDL_RWFromMappedFile(fullpath.c_str()) : NULL;
+	if (rw != NULL)
+	{
+		if (LoadProfiler::isEnabled()) { LoadProfiler::addBytesRead(SDL_RWsize(rw)); }
 	}
+	else if (isEmptyFile(*this))
+	{
+		return std::unique_ptr<std::istream>(new std::istringstream());
+	}
+	else
+	{
+		rw = getRWopsReadAll();
+	}
+	if (rw == NULL) {
+		auto err = "FileRecord::getIStream(): failed to read " + fullpath;
+		Log(LOG_FATAL) << err;
+		throw Exception(err);
+	}
+	return std::unique_ptr<std::istream>(new RWopsMemoryStream(rw));
 }
 
 YAML::Node FileRecord::getYAML() const
@@ -418,7 +600,11 @@ struct VFSLayer {
 	*/
 	bool mapZipFile(const std::string& zippath, const std::string& prefix, bool ignore_ruls = false) {
 		std::string log_ctx = "mapZipFile(" + zippath + ",  '" + prefix + "',  '" + (ignore_ruls ? "true" : "false") + "'): ";
-		SDL_RWops *rwops = SDL_RWFromFile(zippath.c_str(), "r");
+		// zip stays mapped as long as the layer lives, stored entries are then read without copying them
+		SDL_RWops *rwops = SDL_RWFromMappedFile(zippath.c_str());
+		if (!rwops) {
+			rwops = SDL_RWFromFile(zippath.c_str(), "r");
+		}
 		if (!rwops) {
 			Log(LOG_WARNING) << log_ctx << "Ignoring zip '" << zippath << "': " << SDL_GetError();
 			return false;
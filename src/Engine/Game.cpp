@@ -38,6 +38,7 @@
 #include "Options.h"
 #include "CrossPlatform.h"
 #include "FileMap.h"
+#include "LoadProfiler.h"
 #include "Unicode.h"
 #include "../Menu/NotesState.h"
 #include "../Menu/TestState.h"
@@ -59,6 +60,13 @@ Game::Game(const std::string &title) : _screen(0), _cursor(0), _lang(0), _save(0
 	Options::reload = false;
 	Options::mute = false;
 
+	// Geoscape simulation runs without window and sound
+	if (!Options::simulateSave.empty())
+	{
+		SDL_putenv((char *)"SDL_VIDEODRIVER=dummy");
+		SDL_putenv((char *)"SDL_AUDIODRIVER=dummy");
+	}
+
 	// Initialize SDL
 	if (SDL_Init(SDL_INIT_VIDEO) < 0)
 	{
@@ -363,8 +371,8 @@ void Game::run()
  */
 void Game::quit()
 {
-	// Always save ironman
-	if (_save != 0 && _save->isIronman() && !_save->getName().empty())
+	// Always save ironman, except simulated games that must not overwrite the original save
+	if (_save != 0 && _save->isIronman() && !_save->getName().empty() && Options::simulateSave.empty())
 	{
 		std::string filename = CrossPlatform::sanitizeFilename(_save->getName()) + ".sav";
 		_save->save(filename, _mod);
@@ -476,7 +484,9 @@ void Game::loadMods()
 	Mod::resetGlobalStatics();
 	delete _mod;
 	_mod = new Mod();
+	LoadProfiler::reset();
 	_mod->loadAll();
+	LoadProfiler::writeReport();
 }
 
 /**
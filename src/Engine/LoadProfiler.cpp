@@ -0,0 +1,320 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoadProfiler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <typeindex>
+#include <vector>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+#include "CrossPlatform.h"
+#include "Logger.h"
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Number of bytes read by the current thread.
+thread_local size_t bytesReadCount = 0;
+
+/**
+ * Summary of all measurements of one step.
+ */
+struct ProfileEntry
+{
+	std::string category;
+	std::string name;
+	size_t count = 0;
+	double seconds = 0.0;
+	size_t bytes = 0;
+};
+
+std::mutex profileMutex;
+std::map<std::pair<std::string, std::string>, ProfileEntry> profileEntries;
+
+const char *lapCategory = nullptr;
+std::string lapName;
+LoadProfiler::Counters lapStart;
+
+std::string escapeJson(const std::string &str)
+{
+	std::ostringstream out;
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out << '\\' << c;
+		}
+		else if ((unsigned char)c < 0x20)
+		{
+			out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec;
+		}
+		else
+		{
+			out << c;
+		}
+	}
+	return out.str();
+}
+
+std::string escapeCsv(const std::string &str)
+{
+	std::string out = "\"";
+	for (char c : str)
+	{
+		if (c == '"')
+		{
+			out += '"';
+		}
+		out += c;
+	}
+	out += '"';
+	return out;
+}
+
+}
+
+/**
+ * Starts measuring given step, does nothing if profiling is off.
+ * @param category Kind of step, like "mod" or "file".
+ * @param name Name of step.
+ */
+LoadProfiler::Scope::Scope(const char *category, const std::string &name) : _category(category), _enabled(isEnabled())
+{
+	if (_enabled)
+	{
+		_name = name;
+		_start = now();
+	}
+}
+
+/**
+ * Ends measuring of step and adds it to report.
+ */
+LoadProfiler::Scope::~Scope()
+{
+	if (_enabled)
+	{
+		record(_category, _name, _start);
+	}
+}
+
+/**
+ * Gets current counters of the calling thread.
+ * @return Counters.
+ */
+LoadProfiler::Counters LoadProfiler::now()
+{
+	return Counters{ std::chrono::steady_clock::now(), bytesReadCount };
+}
+
+/**
+ * Adds difference between counters of calling thread and start to given entry.
+ * @param category Kind of step.
+ * @param name Name of step.
+ * @param start Counters at start of step.
+ */
+void LoadProfiler::record(const char *category, const std::string &name, const Counters &start)
+{
+	Counters end = now();
+	std::lock_guard<std::mutex> lock(profileMutex);
+	ProfileEntry &entry = profileEntries[std::make_pair(std::string(category), name)];
+	if (entry.count == 0)
+	{
+		entry.category = category;
+		entry.name = name;
+	}
+	entry.count += 1;
+	entry.seconds += std::chrono::duration<double>(end.time - start.time).count();
+	entry.bytes += end.bytes - start.bytes;
+}
+
+/**
+ * Checks if startup profiling was requested on command line.
+ * @return True if profiling is on.
+ */
+bool LoadProfiler::isEnabled()
+{
+	return !Options::startupProfile.empty();
+}
+
+/**
+ * Clears all collected data, used when mods are loaded again.
+ */
+void LoadProfiler::reset()
+{
+	std::lock_guard<std::mutex> lock(profileMutex);
+	profileEntries.clear();
+	lapCategory = nullptr;
+}
+
+/**
+ * Adds bytes read from disk or zip by calling thread.
+ * @param bytes Number of bytes.
+ */
+void LoadProfiler::addBytesRead(size_t bytes)
+{
+	bytesReadCount += bytes;
+}
+
+/**
+ * Ends previous lap and starts new one. Laps measure steps that have
+ * no clear end, like loading of rules of one type. Only main thread can use laps.
+ * @param category Kind of step.
+ * @param name Name of step.
+ */
+void LoadProfiler::lap(const char *category, const std::string &name)
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+	if (lapCategory && std::strcmp(lapCategory, category) == 0 && lapName == name)
+	{
+		return;
+	}
+	endLap();
+	lapCategory = category;
+	lapName = name;
+	lapStart = now();
+}
+
+/**
+ * Ends current lap, if any.
+ */
+void LoadProfiler::endLap()
+{
+	if (lapCategory)
+	{
+		record(lapCategory, lapName, lapStart);
+		lapCategory = nullptr;
+	}
+}
+
+/**
+ * Gets readable name of type, without namespace.
+ * @param type Type info.
+ * @return Name of type.
+ */
+const std::string &LoadProfiler::getTypeName(const std::type_info &type)
+{
+	static std::map<std::type_index, std::string> names;
+	std::lock_guard<std::mutex> lock(profileMutex);
+	auto i = names.find(type);
+	if (i != names.end())
+	{
+		return i->second;
+	}
+	std::string name = type.name();
+#ifdef __GNUC__
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+	if (demangled)
+	{
+		name = demangled;
+		std::free(demangled);
+	}
+#endif
+	for (const char *prefix : { "class ", "struct ", "OpenXcom::" })
+	{
+		const size_t length = std::strlen(prefix);
+		if (name.compare(0, length, prefix) == 0)
+		{
+			name.erase(0, length);
+		}
+	}
+	return names[type] = name;
+}
+
+/**
+ * Writes collected data to "startup_profile.json" or "startup_profile.csv" in user folder.
+ * Entries are grouped by category and sorted from slowest.
+ */
+void LoadProfiler::writeReport()
+{
+	if (!isEnabled())
+	{
+		return;
+	}
+	endLap();
+
+	std::vector<ProfileEntry> entries;
+	{
+		std::lock_guard<std::mutex> lock(profileMutex);
+		for (const auto &i : profileEntries)
+		{
+			entries.push_back(i.second);
+		}
+	}
+	std::stable_sort(entries.begin(), entries.end(),
+		[](const ProfileEntry &a, const ProfileEntry &b)
+		{
+			if (a.category != b.category)
+			{
+				return a.category < b.category;
+			}
+			return a.seconds > b.seconds;
+		}
+	);
+
+	const bool csv = Options::startupProfile == "csv";
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(6);
+	if (csv)
+	{
+		out << "category,name,count,seconds,bytes\n";
+		for (const auto &e : entries)
+		{
+			out << escapeCsv(e.category) << ',' << escapeCsv(e.name) << ',' << e.count << ',' << e.seconds << ',' << e.bytes << '\n';
+		}
+	}
+	else
+	{
+		out << "[\n";
+		for (size_t i = 0; i < entries.size(); ++i)
+		{
+			const auto &e = entries[i];
+			out << "  {\"category\": \"" << escapeJson(e.category) << "\", \"name\": \"" << escapeJson(e.name) << "\", \"count\": " << e.count;
+			out << ", \"seconds\": " << e.seconds << ", \"bytes\": " << e.bytes << "}";
+			out << (i + 1 < entries.size() ? ",\n" : "\n");
+		}
+		out << "]\n";
+	}
+
+	std::string filename = Options::getUserFolder() + "startup_profile." + (csv ? "csv" : "json");
+	if (CrossPlatform::writeFile(filename, out.str()))
+	{
+		Log(LOG_INFO) << "Startup profile written to " << filename;
+	}
+	else
+	{
+		Log(LOG_WARNING) << "Failed to write startup profile: " << filename;
+	}
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <chrono>
+#include <string>
+#include <typeinfo>
+
+namespace OpenXcom
+{
+
+/**
+ * Collects wall time and bytes read of mod loading steps.
+ * Enabled by "-profileStartup json" or "-profileStartup csv" on command line,
+ * report is written to user folder next to the log file.
+ * Nested steps are inclusive, time of mod contains time of all its files.
+ */
+class LoadProfiler
+{
+public:
+	/**
+	 * State of counters of one thread at some point in time.
+	 */
+	struct Counters
+	{
+		std::chrono::steady_clock::time_point time;
+		size_t bytes;
+	};
+
+private:
+	/// Gets current counters of the calling thread.
+	static Counters now();
+	/// Adds difference between counters to given entry.
+	static void record(const char *category, const std::string &name, const Counters &start);
+public:
+	/**
+	 * Measures step for whole lifetime of this object.
+	 */
+	class Scope
+	{
+		const char *_category;
+		std::string _name;
+		Counters _start;
+		bool _enabled;
+	public:
+		/// Starts measuring given step.
+		Scope(const char *category, const std::string &name);
+		/// Ends measuring of step.
+		~Scope();
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+	};
+
+	/// Is profiling requested?
+	static bool isEnabled();
+	/// Clears all collected data.
+	static void reset();
+	/// Adds bytes read by calling thread.
+	static void addBytesRead(size_t bytes);
+	/// Ends previous lap and starts new one.
+	static void lap(const char *category, const std::string &name);
+	/// Ends current lap.
+	static void endLap();
+	/// Gets readable name of type.
+	static const std::string &getTypeName(const std::type_info &type);
+	/// Writes collected data to user folder.
+	static void writeReport();
+};
+
+}
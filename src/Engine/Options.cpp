@@ -26,6 +26,7 @@
 #include <map>
 #include <sstream>
 #include <iostream>
+#include <cstdlib>
 #include <algorithm>
 #include <yaml-cpp/yaml.h>
 #include "Exception.h"
@@ -244,6 +245,9 @@ void create()
 	_info.push_back(OptionInfo("oxceDisableHitLog", &oxceDisableHitLog, false, "", "HIDDEN"));
 	_info.push_back(OptionInfo("oxceDisableAlienInventory", &oxceDisableAlienInventory, false, "", "HIDDEN"));
 	_info.push_back(OptionInfo("oxceDisableInventoryTuCost", &oxceDisableInventoryTuCost, false, "", "HIDDEN"));
+	_info.push_back(OptionInfo("oxceWorkerThreads", &oxceWorkerThreads, 0, "", "HIDDEN"));
+	_info.push_back(OptionInfo("oxceHierarchicalPathfinding", &oxceHierarchicalPathfinding, false, "", "HIDDEN"));
+	_info.push_back(OptionInfo("oxceRulesetCache", &oxceRulesetCache, false, "", "HIDDEN"));
 
 	_info.push_back(OptionInfo("oxceRecommendedOptionsWereSet", &oxceRecommendedOptionsWereSet, false));
 
@@ -501,6 +505,19 @@ static void loadArgs()
 				{
 					_masterMod = argv[i];
 				}
+				else if (argname == "profilestartup")
+				{
+					startupProfile = argv[i];
+					std::transform(startupProfile.begin(), startupProfile.end(), startupProfile.begin(), ::tolower);
+				}
+				else if (argname == "simulate")
+				{
+					simulateSave = argv[i];
+				}
+				else if (argname == "simulatedays")
+				{
+					simulateDays = std::atoi(argv[i].c_str());
+				}
 				else
 				{
 					//save this command line option for now, we will apply it later
@@ -533,6 +550,11 @@ static bool showHelp()
 	help << "        use PATH as the default Config Folder instead of auto-detecting" << std::endl << std::endl;
 	help << "-master MOD" << std::endl;
 	help << "        set MOD to the current master mod (eg. -master xcom2)" << std::endl << std::endl;
+	help << "-profileStartup json|csv" << std::endl;
+	help << "        write timings of mod loading to startup_profile.json or .csv in User Folder" << std::endl << std::endl;
+	help << "-simulate SAVE  [-simulateDays DAYS]" << std::endl;
+	help << "        load SAVE from User Folder, fast-forward Geoscape by DAYS days (default 30) without display" << std::endl;
+	help << "        and player input, then write SAVE_simulated.sav next to SAVE and simulation_report.json to User Folder and quit" << std::endl << std::endl;
 	help << "-KEY VALUE" << std::endl;
 	help << "        override option KEY with VALUE (eg. -displayWidth 640)" << std::endl << std::endl;
 	help << "-help" << std::endl;
@@ -93,6 +93,9 @@ OPT bool oxceDisableProductionDependencyTree;
 OPT bool oxceDisableHitLog;
 OPT bool oxceDisableAlienInventory;
 OPT bool oxceDisableInventoryTuCost;
+OPT int oxceWorkerThreads;
+OPT bool oxceHierarchicalPathfinding;
+OPT bool oxceRulesetCache;
 
 OPT bool oxceRecommendedOptionsWereSet;
 
@@ -102,5 +105,8 @@ OPT std::string password;
 OPT bool mute, reload, newOpenGL, newScaleFilter, newHQXFilter, newXBRZFilter, newRootWindowedMode, newFullscreen, newAllowResize, newBorderless;
 OPT int newDisplayWidth, newDisplayHeight, newBattlescapeScale, newGeoscapeScale, newWindowedModePositionX, newWindowedModePositionY;
 OPT std::string newOpenGLShader;
+OPT std::string startupProfile; // format of startup profiling report (json or csv), empty if off
+OPT std::string simulateSave; // save in user folder to fast-forward without player, empty if off
+OPT int simulateDays; // number of days to fast-forward simulated save
 OPT std::vector< std::pair<std::string, bool> > mods; // ordered list of available mods (lowest priority to highest) and whether they are active
 OPT SoundFormat currentSound;
@@ -76,15 +76,15 @@
 #define PIXEL22_5   *(dp+dpL+dpL+2) = Interp5(w[6], w[8]);
 #define PIXEL22_C   *(dp+dpL+dpL+2) = w[5];
 
-HQX_API void HQX_CALLCONV hq3x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres )
+HQX_API void HQX_CALLCONV hq3x_32_rb_slice(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres, int yFirst, int yLast )
 {
     int  i, j, k;
     int  prevline, nextline;
     uint32_t  w[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
-    const uint8_t* sRowP = (const uint8_t*) sp;
-    const uint8_t* dRowP = (const uint8_t*) dp;
+    const uint8_t* sRowP = (const uint8_t*) sp + yFirst * srb;
+    const uint8_t* dRowP = (const uint8_t*) dp + yFirst * drb * 3;
     uint32_t yuv1, yuv2;
 
     //   +----+----+----+
@@ -98,7 +98,9 @@ HQX_API void HQX_CALLCONV hq3x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t*
     //   | w7 | w8 | w9 |
     //   +----+----+----+
 
-    for (j=0; j<Yres; j++)
+    sp = (const uint32_t*) sRowP;
+    dp = (uint32_t*) dRowP;
+    for (j=yFirst; j<yLast; j++)
     {
         if (j>0)      prevline = -spL;
         else prevline = 0;
@@ -3782,6 +3784,11 @@ HQX_API void HQX_CALLCONV hq3x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t*
     }
 }
 
+HQX_API void HQX_CALLCONV hq3x_32_rb(const uint32_t* sp, uint32_t srb, uint32_t* dp, uint32_t drb, int Xres, int Yres )
+{
+    hq3x_32_rb_slice(sp, srb, dp, drb, Xres, Yres, 0, Yres);
+}
+
 HQX_API void HQX_CALLCONV hq3x_32(const uint32_t* sp, uint32_t* dp, int Xres, int Yres )
 {
     uint32_t rowBytesL = Xres * 4;
@@ -118,6 +118,9 @@ static inline void stage_scale4x(void* dst0, void* dst1, void* dst2, void* dst3,
 #define SCDST(i) (dst+(i)*dst_slice)
 #define SCSRC(i) (src+(i)*src_slice)
 #define SCMID(i) (mid[(i)])
+#define SCROW(y) (src+(y)*src_slice)
+#define SCPREV(y) ((y) > 0 ? (y)-1 : 0)
+#define SCNEXT(y) ((y)+1 < height ? (y)+1 : height-1)
 
 /**
  * Apply the Scale2x effect on a bitmap.
@@ -423,6 +426,71 @@ static void scale4x(void* void_dst, unsigned dst_slice, const void* void_src, un
 #endif
 }
 
+/**
+ * Apply the Scale4x effect on a slice of rows of a bitmap.
+ * Rows outside of the slice are only read as neighbours.
+ * Used internally by ::scale_slice().
+ */
+static void scale4x_slice(void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned first, unsigned last)
+{
+	unsigned char* dst = (unsigned char*)void_dst;
+	const unsigned char* src = (const unsigned char*)void_src;
+	unsigned char* buf;
+	unsigned char* mid[6];
+	unsigned char* tmp;
+	unsigned mid_slice;
+	unsigned i;
+	unsigned y;
+
+	mid_slice = 2 * pixel * width; /* required space for 1 row buffer */
+
+	mid_slice = (mid_slice + 0x7) & ~0x7; /* align to 8 bytes */
+
+	buf = (unsigned char*)malloc(6 * mid_slice); /* each thread need own buffer, stack could be too small */
+
+	if (!buf)
+		return;
+
+	for (i = 0; i < 6; ++i)
+		mid[i] = buf + i * mid_slice;
+
+	/* mid[0], mid[1] are the Scale2x rows of the previous source row, mid[2], mid[3] of the current one and mid[4], mid[5] of the next one */
+	y = first > 0 ? first - 1 : first;
+	stage_scale2x(mid[0], mid[1], SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+	y = first;
+	stage_scale2x(mid[2], mid[3], SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+	y = SCNEXT(first);
+	stage_scale2x(mid[4], mid[5], SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+
+	for (y = first; y < last; ++y) {
+		const unsigned char* above = y > 0 ? mid[1] : mid[2];
+		const unsigned char* below = y + 1 < height ? mid[4] : mid[3];
+		unsigned char* row = dst + 4 * y * dst_slice;
+
+		stage_scale4x(row, row + dst_slice, row + 2 * dst_slice, row + 3 * dst_slice, above, mid[2], mid[3], below, pixel, width);
+
+		tmp = mid[0]; /* shift by 2 position */
+		mid[0] = mid[2];
+		mid[2] = mid[4];
+		mid[4] = tmp;
+		tmp = mid[1];
+		mid[1] = mid[3];
+		mid[3] = mid[5];
+		mid[5] = tmp;
+
+		if (y + 1 < last) {
+			unsigned n = SCNEXT(y + 1);
+			stage_scale2x(mid[4], mid[5], SCROW(SCPREV(n)), SCROW(n), SCROW(SCNEXT(n)), pixel, width);
+		}
+	}
+
+	free(buf);
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	scale2x_mmx_emms();
+#endif
+}
+
 /**
  * Check if the scale implementation is applicable at the given arguments.
  * \param scale Scale factor. 2, 203 (fox 2x3), 204 (for 2x4), 3 or 4.
@@ -499,3 +567,68 @@ void scale(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_
 	}
 }
 
+
+/**
+ * Apply the Scale effect on a slice of rows of a bitmap.
+ * Result is the same as the part of ::scale() output for these rows,
+ * rows outside of the slice are only read as neighbours, so slices
+ * that do not overlap can be scaled by different threads at once.
+ * \param scale Scale factor. 2, 203 (fox 2x3), 204 (for 2x4), 3 or 4.
+ * \param void_dst Pointer at the first pixel of the destination bitmap.
+ * \param dst_slice Size in bytes of a destination bitmap row.
+ * \param void_src Pointer at the first pixel of the source bitmap.
+ * \param src_slice Size in bytes of a source bitmap row.
+ * \param pixel Bytes per pixel of the source and destination bitmap.
+ * \param width Horizontal size in pixels of the source bitmap.
+ * \param height Vertical size in pixels of the source bitmap.
+ * \param first First source row of the slice.
+ * \param last Source row after the end of the slice.
+ */
+void scale_slice(unsigned scale, void* void_dst, unsigned dst_slice, const void* void_src, unsigned src_slice, unsigned pixel, unsigned width, unsigned height, unsigned first, unsigned last)
+{
+	unsigned char* dst = (unsigned char*)void_dst;
+	const unsigned char* src = (const unsigned char*)void_src;
+	unsigned y;
+
+	if (last > height)
+		last = height;
+	if (first >= last)
+		return;
+
+	switch (scale) {
+	case 202 :
+	case 2 :
+		for (y = first; y < last; ++y) {
+			unsigned char* row = dst + 2 * y * dst_slice;
+			stage_scale2x(row, row + dst_slice, SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+		}
+		break;
+	case 203 :
+		for (y = first; y < last; ++y) {
+			unsigned char* row = dst + 3 * y * dst_slice;
+			stage_scale2x3(row, row + dst_slice, row + 2 * dst_slice, SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+		}
+		break;
+	case 204 :
+		for (y = first; y < last; ++y) {
+			unsigned char* row = dst + 4 * y * dst_slice;
+			stage_scale2x4(row, row + dst_slice, row + 2 * dst_slice, row + 3 * dst_slice, SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+		}
+		break;
+	case 303 :
+	case 3 :
+		for (y = first; y < last; ++y) {
+			unsigned char* row = dst + 3 * y * dst_slice;
+			stage_scale3x(row, row + dst_slice, row + 2 * dst_slice, SCROW(SCPREV(y)), SCROW(y), SCROW(SCNEXT(y)), pixel, width);
+		}
+		break;
+	case 404 :
+	case 4 :
+		scale4x_slice(void_dst, dst_slice, void_src, src_slice, pixel, width, height, first, last);
+		return;
+	}
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	scale2x_mmx_emms();
+#endif
+}
@@ -466,37 +466,49 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 
 	if (_proc)
 	{
-		if (_events)
+		auto exe = [&](Uint8 srcStuff, Uint8 destStuff)
+		{
+			ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
+			set(arg);
+			if (_events)
+			{
+				auto ptr = _events;
+				while (*ptr)
+				{
+					reset(arg);
+					scriptExe(*this, ptr->data());
+					++ptr;
+				}
+				++ptr;
+
+				reset(arg);
+				scriptExe(*this, _proc);
+
+				while (*ptr)
+				{
+					reset(arg);
+					scriptExe(*this, ptr->data());
+					++ptr;
+				}
+				++ptr;
+			}
+			else
+			{
+				scriptExe(*this, _proc);
+			}
+			get(arg);
+			return arg.getFirst();
+		};
+
+		if (_destUsed)
 		{
 			ShaderDrawFunc(
 				[&](Uint8& destStuff, const Uint8& srcStuff)
 				{
 					if (srcStuff)
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						auto ptr = _events;
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
-						reset(arg);
-						scriptExe(*this, _proc);
-
-						while (*ptr)
-						{
-							reset(arg);
-							scriptExe(*this, ptr->data());
-							++ptr;
-						}
-						++ptr;
-
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
+						const int result = exe(srcStuff, destStuff);
+						if (result) destStuff = result;
 					}
 				},
 				destShader,
@@ -505,16 +517,22 @@ void ScriptWorkerBlit::executeBlit(Surface* src, Surface* dest, int x, int y, in
 		}
 		else
 		{
+			// all other script arguments are constant during one blit,
+			// then result depends only on source pixel and can be calculated once for each color
+			int lut[256];
+			std::bitset<256> lutReady;
 			ShaderDrawFunc(
 				[&](Uint8& destStuff, const Uint8& srcStuff)
 				{
 					if (srcStuff)
 					{
-						ScriptWorkerBlit::Output arg = { srcStuff, destStuff };
-						set(arg);
-						scriptExe(*this, _proc);
-						get(arg);
-						if (arg.getFirst()) destStuff = arg.getFirst();
+						if (!lutReady.test(srcStuff))
+						{
+							lut[srcStuff] = exe(srcStuff, destStuff);
+							lutReady.set(srcStuff);
+						}
+						const int result = lut[srcStuff];
+						if (result) destStuff = result;
 					}
 				},
 				destShader,
@@ -1851,6 +1869,11 @@ ScriptRefData ParserWriter::getReferece(const ScriptRef& s) const
 	if (ptr == nullptr)
 	{
 		ptr = parser.getRef(s);
+		if (ptr && ptr->isValueType<RegEnum>())
+		{
+			// remember what script parameters are used, some workers can skip work if parameter is unused
+			container._regUsed.set(ptr->getValue<RegEnum>());
+		}
 	}
 	if (ptr == nullptr)
 	{
@@ -18,6 +18,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <map>
+#include <bitset>
 #include <limits>
 #include <vector>
 #include <string>
@@ -374,6 +375,7 @@ class ScriptContainerBase
 {
 	friend struct ParserWriter;
 	std::vector<Uint8> _proc;
+	std::bitset<ScriptMaxReg> _regUsed;
 
 public:
 	/// Constructor.
@@ -402,6 +404,12 @@ public:
 	{
 		return *this ? _proc.data() : nullptr;
 	}
+
+	/// Test if script refers by name to script parameter stored at given reg offset.
+	bool isRegUsed(size_t offset) const
+	{
+		return _regUsed.test(offset);
+	}
 };
 
 /**
@@ -449,6 +457,30 @@ public:
 	{
 		return _events;
 	}
+
+	/// Test if script or any of global events refers to script parameter stored at given reg offset.
+	bool isRegUsed(size_t offset) const
+	{
+		if (_current.isRegUsed(offset))
+		{
+			return true;
+		}
+		if (auto ptr = _events)
+		{
+			// events before and after script, each list end with empty script
+			for (int i = 0; i < 2; ++i, ++ptr)
+			{
+				for (; *ptr; ++ptr)
+				{
+					if (ptr->isRegUsed(offset))
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
 };
 
 /**
@@ -662,7 +694,7 @@ class ScriptWorkerBase
 	}
 	/// Final function of counting offset.
 	template<typename>
-	static constexpr size_t offset(int i, size_t prevOffset)
+	static constexpr size_t offset(int /*i*/, size_t prevOffset)
 	{
 		return prevOffset;
 	}
@@ -674,6 +706,13 @@ class ScriptWorkerBase
 	}
 
 protected:
+	/// Get offset of reg used by output argument.
+	template<typename... Args>
+	static constexpr size_t offsetOutputArg(helper::TypeTag<ScriptOutputArgs<Args...>>, int i)
+	{
+		return offset<void, Args...>(i, 0);
+	}
+
 	/// Update values in script.
 	template<typename Output, typename... Args>
 	void updateBase(Args... args)
@@ -800,16 +839,23 @@ public:
  */
 class ScriptWorkerBlit : public ScriptWorkerBase
 {
+public:
+	/// Type of output value from script.
+	using Output = ScriptOutputArgs<int&, int>;
+
+private:
+	/// Offset of reg with destination pixel.
+	static constexpr size_t DestPixelReg = offsetOutputArg(helper::TypeTag<Output>{}, 1);
+
 	/// Current script set in worker.
 	const Uint8* _proc;
 	const ScriptContainerBase* _events;
+	/// Do script read destination pixel.
+	bool _destUsed;
 
 public:
-	/// Type of output value from script.
-	using Output = ScriptOutputArgs<int&, int>;
-
 	/// Default constructor.
-	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr)
+	ScriptWorkerBlit() : ScriptWorkerBase(), _proc(nullptr), _events(nullptr), _destUsed(true)
 	{
 
 	}
@@ -824,6 +870,7 @@ public:
 		{
 			_proc = c.data();
 			_events = nullptr;
+			_destUsed = c.isRegUsed(DestPixelReg);
 			updateBase<Output>(args...);
 		}
 	}
@@ -838,6 +885,7 @@ public:
 		{
 			_proc = c.data();
 			_events = c.dataEvents();
+			_destUsed = c.isRegUsed(DestPixelReg);
 			updateBase<Output>(args...);
 		}
 	}
@@ -852,6 +900,7 @@ public:
 	{
 		_proc = nullptr;
 		_events = nullptr;
+		_destUsed = true;
 	}
 };
 
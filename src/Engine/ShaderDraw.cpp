@@ -0,0 +1,169 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ShaderDraw.h"
+#include "Zoom.h"
+
+#if (_MSC_VER >= 1400) || (defined(__MINGW32__) && defined(__SSE2__))
+
+#ifndef __SSE2__
+#define __SSE2__ true
+#endif
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace OpenXcom
+{
+
+namespace helper
+{
+
+#ifdef __SSE2__
+
+namespace
+{
+
+/// Is SSE2 available on this CPU? Checked once at startup.
+const bool useSSE2 = Zoom::haveSSE2();
+
+/// Number of pixels in one SSE2 register.
+const int SSE2Width = 16;
+
+/**
+ * Selects pixels from `a` where mask is set and from `b` elsewhere.
+ */
+inline __m128i select(__m128i mask, __m128i a, __m128i b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+}
+
+#endif
+
+/**
+ * Vectorized version of `StandardShade::func` for part of row.
+ * @param size Number of pixels in row.
+ * @param dest Destination pixels.
+ * @param src Source pixels.
+ * @param shade Shade offset.
+ * @return Number of pixels done, rest of row need be done by scalar code.
+ */
+int StandardShadeRow(int size, Uint8* dest, const Uint8* src, int shade)
+{
+#ifdef __SSE2__
+	if (!useSSE2)
+	{
+		return 0;
+	}
+	const int done = size & ~(SSE2Width - 1);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i group = _mm_set1_epi8((char)ColorGroup);
+	const __m128i black = _mm_set1_epi8((char)ColorShade);
+	const __m128i shadeVec = _mm_set1_epi8((char)shade);
+	for (int i = 0; i < done; i += SSE2Width)
+	{
+		const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+		const __m128i newShade = _mm_add_epi8(s, shadeVec);
+		// so dark it would flip over to another color - make it black instead
+		const __m128i sameGroup = _mm_cmpeq_epi8(_mm_and_si128(_mm_xor_si128(newShade, s), group), zero);
+		const __m128i n = select(sameGroup, newShade, black);
+		const __m128i transparent = _mm_cmpeq_epi8(s, zero);
+		_mm_storeu_si128((__m128i*)(dest + i), select(transparent, d, n));
+	}
+	return done;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Vectorized version of `ColorReplace::func` for part of row.
+ * @param size Number of pixels in row.
+ * @param dest Destination pixels.
+ * @param src Source pixels.
+ * @param shade Shade offset.
+ * @param newColor New color group.
+ * @return Number of pixels done, rest of row need be done by scalar code.
+ */
+int ColorReplaceRow(int size, Uint8* dest, const Uint8* src, int shade, int newColor)
+{
+#ifdef __SSE2__
+	if (!useSSE2)
+	{
+		return 0;
+	}
+	const int done = size & ~(SSE2Width - 1);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i group = _mm_set1_epi8((char)ColorGroup);
+	const __m128i black = _mm_set1_epi8((char)ColorShade);
+	const __m128i shadeVec = _mm_set1_epi8((char)shade);
+	const __m128i colorVec = _mm_set1_epi8((char)newColor);
+	for (int i = 0; i < done; i += SSE2Width)
+	{
+		const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+		const __m128i newShade = _mm_add_epi8(_mm_and_si128(s, black), shadeVec);
+		// so dark it would flip over to another color - make it black instead
+		const __m128i inGroup = _mm_cmpeq_epi8(_mm_and_si128(newShade, group), zero);
+		const __m128i n = select(inGroup, _mm_or_si128(colorVec, newShade), black);
+		const __m128i transparent = _mm_cmpeq_epi8(s, zero);
+		_mm_storeu_si128((__m128i*)(dest + i), select(transparent, d, n));
+	}
+	return done;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Vectorized version of `MaskedCopy::func` for part of row.
+ * @param size Number of pixels in row.
+ * @param dest Destination pixels.
+ * @param src Source pixels.
+ * @return Number of pixels done, rest of row need be done by scalar code.
+ */
+int MaskedCopyRow(int size, Uint8* dest, const Uint8* src)
+{
+#ifdef __SSE2__
+	if (!useSSE2)
+	{
+		return 0;
+	}
+	const int done = size & ~(SSE2Width - 1);
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < done; i += SSE2Width)
+	{
+		const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dest + i));
+		const __m128i transparent = _mm_cmpeq_epi8(s, zero);
+		_mm_storeu_si128((__m128i*)(dest + i), select(transparent, d, s));
+	}
+	return done;
+#else
+	return 0;
+#endif
+}
+
+}//namespace helper
+
+}//namespace OpenXcom
@@ -30,13 +30,45 @@ static inline First&& GetFirst(First&& f, Rest&&... r)
 	return std::forward<First>(f);
 }
 
+namespace helper
+{
+
+/**
+ * Calls vectorized row function of `ColorFunc` if it have one
+ * and all arguments are simple surfaces or scalars.
+ * @return Number of pixels done.
+ */
+template<typename ColorFunc, typename... Ctrl>
+static inline auto callRow(int size, int, Ctrl&... c) -> decltype(ColorFunc::funcRow(size, c.get_row()...))
+{
+	const int done = ColorFunc::funcRow(size, c.get_row()...);
+	if (done)
+	{
+		(c.add_x(done), ...);
+	}
+	return done;
+}
+
+/**
+ * Fallback for functions and arguments without vectorized version.
+ * @return Zero pixels done.
+ */
+template<typename ColorFunc, typename... Ctrl>
+static inline int callRow(int, long, Ctrl&...)
+{
+	return 0;
+}
+
+}//namespace helper
+
 /**
  * Universal blit function implementation.
  * @param f called function.
+ * @param row function that can do part of row at once, return number of done pixels.
  * @param src source surfaces control objects.
  */
-template<typename Func, typename... SrcType>
-static inline void ShaderDrawImpl(Func&& f, helper::controler<SrcType>... src)
+template<typename Func, typename Row, typename... SrcType>
+static inline void ShaderDrawImpl(Func&& f, Row&& row, helper::controler<SrcType>... src)
 {
 	//get basic draw range in 2d space
 	GraphSubset end_temp = GetFirst(src...).get_range();
@@ -78,6 +110,8 @@ static inline void ShaderDrawImpl(Func&& f, helper::controler<SrcType>... src)
 		(src.set_x(begin_x, end_x), ...);
 
 		int size_x = end_x-begin_x;
+		//vectorized part of x-axis
+		size_x -= row(size_x, src...);
 		//iteration on x-axis
 		for (int x = size_x / 4; x>0; --x)
 		{
@@ -108,7 +142,11 @@ static inline void ShaderDrawImpl(Func&& f, helper::controler<SrcType>... src)
 template<typename ColorFunc, typename... SrcType>
 static inline void ShaderDraw(const SrcType&... src_frame)
 {
-	ShaderDrawImpl([](auto&&... a){ ColorFunc::func(std::forward<decltype(a)>(a)...); }, helper::controler<SrcType>(src_frame)...);
+	ShaderDrawImpl(
+		[](auto&&... a){ ColorFunc::func(std::forward<decltype(a)>(a)...); },
+		[](int size, auto&... c){ return helper::callRow<ColorFunc>(size, 0, c...); },
+		helper::controler<SrcType>(src_frame)...
+	);
 }
 
 /**
@@ -119,7 +157,7 @@ static inline void ShaderDraw(const SrcType&... src_frame)
 template<typename Func, typename... SrcType>
 static inline void ShaderDrawFunc(Func&& f, const SrcType&... src_frame)
 {
-	ShaderDrawImpl(std::forward<Func>(f), helper::controler<SrcType>(src_frame)...);
+	ShaderDrawImpl(std::forward<Func>(f), [](int, auto&...){ return 0; }, helper::controler<SrcType>(src_frame)...);
 }
 
 namespace helper
@@ -128,6 +166,13 @@ namespace helper
 const Uint8 ColorGroup = 0xF0;
 const Uint8 ColorShade = 0x0F;
 
+/// Vectorized row of `StandardShade`, return number of pixels done.
+int StandardShadeRow(int size, Uint8* dest, const Uint8* src, int shade);
+/// Vectorized row of `ColorReplace`, return number of pixels done.
+int ColorReplaceRow(int size, Uint8* dest, const Uint8* src, int shade, int newColor);
+/// Vectorized row of `MaskedCopy`, return number of pixels done.
+int MaskedCopyRow(int size, Uint8* dest, const Uint8* src);
+
 /**
  * help class used for Surface::blitNShade
  */
@@ -169,6 +214,14 @@ struct ColorReplace
 #endif
 	}
 
+	/**
+	 * Vectorized version of `func` used by ShaderDraw for long rows.
+	 * @return Number of pixels done.
+	 */
+	static inline int funcRow(int size, Uint8* dest, const Uint8* src, const int& shade, const int& newColor)
+	{
+		return ColorReplaceRow(size, dest, src, shade, newColor);
+	}
 };
 
 /**
@@ -213,6 +266,42 @@ struct StandardShade
 #endif
 	}
 
+	/**
+	 * Vectorized version of `func` used by ShaderDraw for long rows.
+	 * @return Number of pixels done.
+	 */
+	static inline int funcRow(int size, Uint8* dest, const Uint8* src, const int& shade)
+	{
+		return StandardShadeRow(size, dest, src, shade);
+	}
+};
+
+/**
+ * help class used for blitting surfaces with transparent color 0
+ */
+struct MaskedCopy
+{
+	/**
+	 * Copy source pixel if it is not transparent.
+	 * @param dest destination pixel
+	 * @param src source pixel
+	 */
+	static inline void func(Uint8& dest, const Uint8& src)
+	{
+		if (src)
+		{
+			dest = src;
+		}
+	}
+
+	/**
+	 * Vectorized version of `func` used by ShaderDraw for long rows.
+	 * @return Number of pixels done.
+	 */
+	static inline int funcRow(int size, Uint8* dest, const Uint8* src)
+	{
+		return MaskedCopyRow(size, dest, src);
+	}
 };
 /**
  * helper class used for blitting dying unit with overkill
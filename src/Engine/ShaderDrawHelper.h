@@ -236,11 +236,19 @@ struct controler<Scalar<T> >
 	{
 		//nothing
 	}
+	inline void add_x(int)
+	{
+		//nothing
+	}
 
 	inline T& get_ref()
 	{
 		return ref;
 	}
+	inline T& get_row()
+	{
+		return ref;
+	}
 };
 
 template<typename PixelPtr, typename PixelRef>
@@ -311,11 +319,20 @@ struct controler_base
 	{
 		ptr_pos_x = pointerByteOffset(ptr_pos_x, step.first);
 	}
+	inline void add_x(int n)
+	{
+		ptr_pos_x = pointerByteOffset(ptr_pos_x, step.first * n);
+	}
 
 	inline PixelRef get_ref()
 	{
 		return *ptr_pos_x;
 	}
+	/// Pointer to current pixel, next pixels of row follow it in memory.
+	inline PixelPtr get_row()
+	{
+		return ptr_pos_x;
+	}
 };
 
 
@@ -40,19 +40,56 @@ Sound::UniqueSoundPtr Sound::NewSound(Mix_Chunk* sound)
 }
 
 /**
- * Loads a sound file from a specified filename.
+ * Loads sound content from a specified filename.
  * @param filename Filename of the sound file.
+ * @return Loaded sound, null if the file could not be decoded.
  */
-void Sound::load(const std::string &filename) {
+Sound::UniqueSoundPtr Sound::loadFile(const std::string &filename)
+{
 	auto rw = FileMap::getRWops(filename);
 	auto s = NewSound(Mix_LoadWAV_RW(rw, SDL_TRUE));
 	if (!s)
 	{
 		Log(LOG_ERROR) << "Sound::load(" << filename << "): mix error=" << Mix_GetError();
 	}
+	return s;
+}
 
+/**
+ * Loads a sound file from a specified filename.
+ * @param filename Filename of the sound file.
+ */
+void Sound::load(const std::string &filename) {
 	//always overwrite
-	_sound = std::move(s);
+	_sound = loadFile(filename);
+	_lazyFile.clear();
+}
+
+/**
+ * Sets a sound file to be loaded when the sound is first played.
+ * The file need exist already, so missing files are reported when mod is loaded.
+ * @param filename Filename of the sound file.
+ */
+void Sound::loadLazy(const std::string &filename)
+{
+	if (!FileMap::fileExists(filename))
+	{
+		throw Exception("Sound::loadLazy(" + filename + "): requested file not found.");
+	}
+	_sound = nullptr;
+	_lazyFile = filename;
+}
+
+/**
+ * Loads the sound file set by loadLazy, if it was not loaded yet.
+ */
+void Sound::loadLazyData() const
+{
+	if (!_lazyFile.empty())
+	{
+		_sound = loadFile(_lazyFile);
+		_lazyFile.clear();
+	}
 }
 
 /**
@@ -68,6 +105,7 @@ void Sound::load(SDL_RWops *rw) {
 
 	//always overwrite
 	_sound = std::move(s);
+	_lazyFile.clear();
 }
 
 /**
@@ -76,6 +114,7 @@ void Sound::load(SDL_RWops *rw) {
  */
 void Sound::play(int channel, int angle, int distance) const
  {
+	loadLazyData();
 	if (!Options::mute && _sound)
  	{
 		int chan = Mix_PlayChannel(channel, _sound.get(), 0);
@@ -109,6 +148,7 @@ void Sound::stop()
  */
 void Sound::loop()
 {
+	loadLazyData();
 	if (!Options::mute && _sound && Mix_Playing(3) == 0)
 	{
 		int chan = Mix_PlayChannel(3, _sound.get(), -1);
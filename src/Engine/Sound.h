@@ -43,7 +43,13 @@ public:
 	static UniqueSoundPtr NewSound(Mix_Chunk* sound);
 
 private:
-	UniqueSoundPtr _sound;
+	mutable UniqueSoundPtr _sound;
+	mutable std::string _lazyFile;
+
+	/// Loads sound content from file.
+	static UniqueSoundPtr loadFile(const std::string &filename);
+	/// Loads sound set by loadLazy.
+	void loadLazyData() const;
 
 public:
 	/// Creates a blank sound effect.
@@ -59,6 +65,8 @@ public:
 	void load(const std::string &filename);
 	/// Loads sound from SDL_RWops
 	void load(SDL_RWops *rw);
+	/// Sets sound to be loaded from the specified file when first played.
+	void loadLazy(const std::string &filename);
 	/// Plays the sound.
 	void play(int channel = -1, int angle = 0, int distance = 0) const;
 	/// Stops all sounds.
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "StringId.h"
+#include <deque>
+#include <unordered_map>
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Global table of interned strings.
+ * Deque keeps strings in place, so returned references stay valid.
+ */
+struct StringTable
+{
+	std::deque<std::string> strings;
+	std::unordered_map<std::string, int> indexes;
+};
+
+StringTable &getTable()
+{
+	static StringTable table;
+	return table;
+}
+
+}
+
+/**
+ * Gets ID of string, new strings are added to end of table.
+ * @param str String to intern.
+ */
+StringId::StringId(const std::string &str)
+{
+	StringTable &table = getTable();
+	auto i = table.indexes.find(str);
+	if (i != table.indexes.end())
+	{
+		_index = i->second;
+	}
+	else
+	{
+		_index = (int)table.strings.size();
+		table.strings.push_back(str);
+		table.indexes[str] = _index;
+	}
+}
+
+/**
+ * Gets ID of string only if it is already in table.
+ * @param str String to find.
+ * @return ID of string or invalid ID.
+ */
+StringId StringId::find(const std::string &str)
+{
+	StringTable &table = getTable();
+	auto i = table.indexes.find(str);
+	if (i != table.indexes.end())
+	{
+		return StringId(i->second);
+	}
+	return StringId();
+}
+
+/**
+ * Gets number of strings in table, all valid IDs are smaller than this.
+ * @return Size of table.
+ */
+int StringId::getTableSize()
+{
+	return (int)getTable().strings.size();
+}
+
+/**
+ * Gets string of ID, invalid ID gives empty string.
+ * @return Interned string.
+ */
+const std::string &StringId::str() const
+{
+	static const std::string empty;
+	if (_index < 0)
+	{
+		return empty;
+	}
+	return getTable().strings[_index];
+}
+
+}
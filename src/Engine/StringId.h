@@ -0,0 +1,149 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace OpenXcom
+{
+
+template<typename T>
+class StringIdArray;
+
+/**
+ * Dense integer ID of string stored in global interning table.
+ * Every distinct string gets its own ID and keeps it for whole run of program,
+ * names of all rules are interned when rulesets are loaded.
+ * Table is not thread safe, new strings can be only added from main thread.
+ */
+class StringId
+{
+	int _index;
+
+	/// Creates ID from raw index.
+	explicit StringId(int index) : _index(index) { }
+
+	template<typename T>
+	friend class StringIdArray;
+public:
+	/// Creates invalid ID.
+	StringId() : _index(-1) { }
+	/// Gets ID of string, adds it to table if needed.
+	explicit StringId(const std::string &str);
+
+	/// Gets ID of string, adds it to table if needed.
+	static StringId intern(const std::string &str) { return StringId(str); }
+	/// Gets ID of string without adding it to table, unknown strings give invalid ID.
+	static StringId find(const std::string &str);
+	/// Gets number of strings in table.
+	static int getTableSize();
+
+	/// Is this ID of some string?
+	bool isValid() const { return _index >= 0; }
+	/// Gets index of ID, usable for flat arrays.
+	int getIndex() const { return _index; }
+	/// Gets string of ID.
+	const std::string &str() const;
+
+	bool operator==(StringId other) const { return _index == other._index; }
+	bool operator!=(StringId other) const { return _index != other._index; }
+	bool operator<(StringId other) const { return _index < other._index; }
+};
+
+/**
+ * Flat array of values indexed by StringId, default value means no entry.
+ * Replacement for `std::map<std::string, T>` in hot code.
+ */
+template<typename T>
+class StringIdArray
+{
+	std::vector<T> _data;
+public:
+	/// Gets value of ID, default for missing ones.
+	T get(StringId id) const
+	{
+		if (id.isValid() && (size_t)id.getIndex() < _data.size())
+		{
+			return _data[id.getIndex()];
+		}
+		return T{};
+	}
+	/// Gets value of string, default for missing ones.
+	T get(const std::string &str) const
+	{
+		return get(StringId::find(str));
+	}
+	/// Gets value of ID to change, adds it if needed. ID need to be valid.
+	T &operator[](StringId id)
+	{
+		if ((size_t)id.getIndex() >= _data.size())
+		{
+			_data.resize(id.getIndex() + 1);
+		}
+		return _data[id.getIndex()];
+	}
+	/// Gets value of string to change, adds it if needed.
+	T &operator[](const std::string &str)
+	{
+		return (*this)[StringId(str)];
+	}
+	/// Removes all values.
+	void clear()
+	{
+		_data.clear();
+	}
+	/// Calls function for each non default value.
+	void forEach(const std::function<void(StringId, const T&)> &func) const
+	{
+		for (size_t i = 0; i < _data.size(); ++i)
+		{
+			if (_data[i] != T{})
+			{
+				func(StringId((int)i), _data[i]);
+			}
+		}
+	}
+
+	/// Loads values from map used in YAML files.
+	void fromMap(const std::map<std::string, T> &map)
+	{
+		_data.clear();
+		for (const auto &p : map)
+		{
+			(*this)[p.first] = p.second;
+		}
+	}
+	/// Gets values as map used in YAML files, sorted by name.
+	std::map<std::string, T> toMap() const
+	{
+		std::map<std::string, T> map;
+		for (size_t i = 0; i < _data.size(); ++i)
+		{
+			if (_data[i] != T{})
+			{
+				map[StringId((int)i).str()] = _data[i];
+			}
+		}
+		return map;
+	}
+};
+
+}
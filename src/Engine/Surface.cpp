@@ -1067,14 +1067,7 @@ void SurfaceCrop::blit(Surface* dest)
 		auto srcShader = ShaderCrop(*this, _x, _y);
 		auto destShader = ShaderMove<Uint8>(dest, 0, 0);
 
-		ShaderDrawFunc(
-			[](Uint8& d, Uint8 s)
-			{
-				if (s) d = s;
-			},
-			destShader,
-			srcShader
-		);
+		ShaderDraw<helper::MaskedCopy>(destShader, srcShader);
 	}
 }
 
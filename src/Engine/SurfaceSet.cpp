@@ -17,6 +17,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "SurfaceSet.h"
+#include <algorithm>
+#include <cassert>
 #include <climits>
 #include "Surface.h"
 #include "Exception.h"
@@ -44,6 +46,9 @@ SurfaceSet::SurfaceSet(const SurfaceSet& other)
 	_width = other._width;
 	_height = other._height;
 	_sharedFrames = other._sharedFrames;
+	_lazyFrames = other._lazyFrames;
+	_paletteUsed = other._paletteUsed;
+	std::copy(std::begin(other._palette), std::end(other._palette), std::begin(_palette));
 
 	_frames.resize(other._frames.size());
 	for (size_t i = 0; i < _frames.size(); ++i)
@@ -72,6 +77,7 @@ SurfaceSet::~SurfaceSet()
 void SurfaceSet::loadPck(const std::string &pck, const std::string &tab)
 {
 	_frames.clear();
+	_lazyFrames.clear();
 
 	int nframes = 0;
 
@@ -167,6 +173,7 @@ void SurfaceSet::loadDat(const std::string &filename)
 	nframes = (int)size / (_width * _height);
 
 	_frames.resize(nframes);
+	_lazyFrames.clear();
 	for (int i = 0; i < nframes; ++i)
 	{
 		_frames[i] = Surface(_width, _height);
@@ -212,10 +219,51 @@ Surface *SurfaceSet::getFrame(int i)
 		{
 			return &_frames[i];
 		}
+		if (!_lazyFrames.empty())
+		{
+			return loadLazyFrame(i);
+		}
 	}
 	return nullptr;
 }
 
+/**
+ * Loads image of frame added by addLazyFrame and applies
+ * all palette changes that were done to the set before.
+ * Errors of image decoding are passed to caller, frame stays
+ * unloaded in that case.
+ * @param i Frame number in the set.
+ * @return Pointer to the loaded surface or null if there is no such frame.
+ */
+Surface *SurfaceSet::loadLazyFrame(int i)
+{
+	auto lazy = _lazyFrames.find(i);
+	if (lazy == _lazyFrames.end())
+	{
+		return nullptr;
+	}
+
+	Surface frame(_width, _height);
+	frame.loadImage(lazy->second);
+	for (int c = 0; c < 256;)
+	{
+		if (!_paletteUsed.test(c))
+		{
+			++c;
+			continue;
+		}
+		int first = c;
+		while (c < 256 && _paletteUsed.test(c))
+		{
+			++c;
+		}
+		frame.setPalette(_palette + first, first, c - first);
+	}
+	_frames[i] = std::move(frame);
+	_lazyFrames.erase(lazy);
+	return &_frames[i];
+}
+
 /**
  * Creates and returns a particular frame in the surface set.
  * @param i Frame number in the set.
@@ -232,10 +280,37 @@ Surface *SurfaceSet::addFrame(int i)
 	{
 		_frames.resize(i + 1);
 	}
+	_lazyFrames.erase(i);
 	_frames[i] = Surface(_width, _height);
 	return &_frames[i];
 }
 
+/**
+ * Sets a particular frame in the surface set to be loaded
+ * from an image file when it's first requested.
+ * Any existing frame with the same number is replaced.
+ * File is opened once to check it, so missing or unreadable
+ * files are reported when the set is loaded, not when it's drawn.
+ * @param i Frame number in the set.
+ * @param filename Filename of the image.
+ */
+void SurfaceSet::addLazyFrame(int i, const std::string &filename)
+{
+	assert(i >= 0 && "Negative indexes are not supported in SurfaceSet");
+	SDL_RWops *rw = FileMap::getRWops(filename);
+	if (!rw)
+	{
+		throw Exception(filename + ": file can't be opened.");
+	}
+	SDL_RWclose(rw);
+	if ((size_t)i >= _frames.size())
+	{
+		_frames.resize(i + 1);
+	}
+	_frames[i] = Surface();
+	_lazyFrames[i] = filename;
+}
+
 /**
  * Returns the full width of a frame in the set.
  * @return Width in pixels.
@@ -295,6 +370,12 @@ size_t SurfaceSet::getTotalFrames() const
  */
 void SurfaceSet::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 {
+	// remember colors for frames that are not loaded yet
+	for (int c = 0; c < ncolors && firstcolor + c < 256; ++c)
+	{
+		_palette[firstcolor + c] = colors[c];
+		_paletteUsed.set(firstcolor + c);
+	}
 	for (size_t i = 0; i < _frames.size(); ++i)
 	{
 		if (_frames[i])
@@ -18,6 +18,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <bitset>
+#include <map>
 #include <vector>
 #include <string>
 #include <SDL.h>
@@ -37,9 +39,15 @@ class SurfaceSet
 {
 private:
 	std::vector<Surface> _frames;
+	std::map<int, std::string> _lazyFrames;
+	SDL_Color _palette[256];
+	std::bitset<256> _paletteUsed;
 	int _width, _height;
 	int _sharedFrames;
 
+	/// Loads a frame that was added without loading its image.
+	Surface *loadLazyFrame(int i);
+
 public:
 	/// Crates a surface set with frames of the specified size.
 	SurfaceSet(int width, int height);
@@ -55,6 +63,8 @@ public:
 	Surface *getFrame(int i);
 	/// Creates a new surface and returns a pointer to it.
 	Surface *addFrame(int i);
+	/// Sets a frame to be loaded from an image file on first use.
+	void addLazyFrame(int i, const std::string &filename);
 	/// Gets the width of all frames.
 	int getWidth() const;
 	/// Gets the height of all frames.
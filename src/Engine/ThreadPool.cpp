@@ -0,0 +1,241 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Options.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * Shared state of all worker threads.
+ */
+struct PoolState
+{
+	/// Held by the thread that currently submits jobs to the pool.
+	std::mutex owner;
+	std::mutex mutex;
+	std::condition_variable wake, done;
+	std::vector<std::thread> threads;
+	const std::function<void(int)> *job = nullptr;
+	std::atomic<int> next{ 0 };
+	int count = 0;
+	int busy = 0;
+	int generation = 0;
+	bool quit = false;
+	std::exception_ptr error;
+
+	~PoolState()
+	{
+		stop();
+	}
+
+	/**
+	 * Takes indexes from the current job until none are left.
+	 * @param func Job function.
+	 * @param size Number of indexes in job.
+	 */
+	void work(const std::function<void(int)> *func, int size)
+	{
+		for (int i = next++; i < size; i = next++)
+		{
+			try
+			{
+				(*func)(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error)
+				{
+					error = std::current_exception();
+				}
+				next = size;
+			}
+		}
+	}
+
+	/**
+	 * Stops and joins all threads.
+	 */
+	void stop()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+		for (auto &t : threads)
+		{
+			t.join();
+		}
+		threads.clear();
+		quit = false;
+	}
+};
+
+PoolState pool;
+thread_local bool workerThread = false;
+
+/**
+ * Main loop of worker thread.
+ */
+void workerLoop()
+{
+	workerThread = true;
+	int seen = 0;
+	std::unique_lock<std::mutex> lock(pool.mutex);
+	while (true)
+	{
+		pool.wake.wait(lock, [&]{ return pool.quit || pool.generation != seen; });
+		if (pool.quit)
+		{
+			return;
+		}
+		seen = pool.generation;
+		if (!pool.job)
+		{
+			// calling thread already finished this job alone
+			continue;
+		}
+		const std::function<void(int)> *job = pool.job;
+		const int count = pool.count;
+		++pool.busy;
+		lock.unlock();
+		pool.work(job, count);
+		lock.lock();
+		if (--pool.busy == 0)
+		{
+			pool.done.notify_all();
+		}
+	}
+}
+
+/**
+ * Creates or removes workers to match current options.
+ */
+void updateWorkers()
+{
+	size_t wanted = (size_t)std::max(0, Options::oxceWorkerThreads);
+	if (pool.threads.size() != wanted)
+	{
+		pool.stop();
+		for (size_t i = 0; i < wanted; ++i)
+		{
+			pool.threads.push_back(std::thread(workerLoop));
+		}
+	}
+}
+
+}
+
+/**
+ * Runs job(i) for every i in [0, count). Calling thread takes part in work too.
+ * Calls from inside of a job are run directly on the current thread,
+ * same as calls from other threads while the pool is used by someone else
+ * (eg. mod loading thread and screen scaling on main thread).
+ * If any job throws, remaining jobs are skipped and the exception is rethrown here.
+ * @param count Number of jobs.
+ * @param job Function to call with index of job.
+ */
+void ThreadPool::parallelFor(int count, const std::function<void(int)> &job)
+{
+	if (count > 1 && tryParallelFor(count, job))
+	{
+		return;
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		job(i);
+	}
+}
+
+/**
+ * Runs job(i) for every i in [0, count) on the pool, if the pool can be used right now.
+ * Nothing is run when pool has no workers, is used by another thread,
+ * or when called from inside of a job, caller then need do the work other way.
+ * If any job throws, remaining jobs are skipped and the exception is rethrown here.
+ * @param count Number of jobs.
+ * @param job Function to call with index of job.
+ * @return True if all jobs were run.
+ */
+bool ThreadPool::tryParallelFor(int count, const std::function<void(int)> &job)
+{
+	if (workerThread)
+	{
+		return false;
+	}
+	std::unique_lock<std::mutex> owner(pool.owner, std::try_to_lock);
+	if (!owner.owns_lock())
+	{
+		return false;
+	}
+	updateWorkers();
+	if (pool.threads.empty())
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pool.mutex);
+		pool.job = &job;
+		pool.count = count;
+		pool.next = 0;
+		pool.error = nullptr;
+		++pool.generation;
+	}
+	pool.wake.notify_all();
+
+	pool.work(&job, count);
+
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock(pool.mutex);
+		pool.done.wait(lock, []{ return pool.busy == 0; });
+		pool.job = nullptr;
+		pool.count = 0;
+		error = pool.error;
+		pool.error = nullptr;
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+	return true;
+}
+
+/**
+ * Gets number of threads that can run jobs at once.
+ * @return Number of workers plus the calling thread.
+ */
+int ThreadPool::getThreadCount()
+{
+	return 1 + std::max(0, Options::oxceWorkerThreads);
+}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <functional>
+
+namespace OpenXcom
+{
+
+/**
+ * Pool of worker threads used to split heavy calculations into independent jobs.
+ * Size of pool is set by Options::oxceWorkerThreads, zero means everything is done
+ * on the calling thread, exactly as without the pool.
+ * Jobs must not touch any shared state that other jobs of the same call write to,
+ * results need to be merged by the caller after all jobs finish.
+ */
+class ThreadPool
+{
+public:
+	/// Runs a job for every index in range, returns when all jobs are done.
+	static void parallelFor(int count, const std::function<void(int)> &job);
+	/// Runs a job for every index in range if pool is free, returns false without running anything otherwise.
+	static bool tryParallelFor(int count, const std::function<void(int)> &job);
+	/// Gets number of threads that can run jobs at once (including the calling thread).
+	static int getThreadCount();
+};
+
+}
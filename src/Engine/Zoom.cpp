@@ -18,11 +18,13 @@
  */
 
 #include "Zoom.h"
+#include <algorithm>
 
 #include "Surface.h"
 #include "Logger.h"
 #include "Options.h"
 #include "Screen.h"
+#include "ThreadPool.h"
 
 #include "OpenGL.h"
 
@@ -647,6 +649,31 @@ bool Zoom::haveSSE2()
 
 #endif
 
+namespace
+{
+
+/// Smallest number of source rows given to one worker, thinner bands cost more in overhead than they save.
+const int MinScaleBandRows = 16;
+
+/**
+ * Splits source image into horizontal bands and scales them on worker threads.
+ * Each filter reads rows around the band as neighbours, but writes only
+ * destination rows of its own band, so bands can be done at once.
+ * @param height Height of source image.
+ * @param slice Function that scales source rows from first to last (exclusive).
+ */
+void scaleInBands(int height, const std::function<void(int, int)> &slice)
+{
+	const int bands = std::min(ThreadPool::getThreadCount(), height / MinScaleBandRows);
+	// pool can be busy with other thread, eg. mods loading, then do whole image at once
+	if (bands <= 1 || !ThreadPool::tryParallelFor(bands, [&](int i) { slice(height * i / bands, height * (i + 1) / bands); }))
+	{
+		slice(0, height);
+	}
+}
+
+}
+
 /**
  * Wrapper around various software and OpenGL screen buffer pushing functions which zoom.
  * Basically called just from Screen::flip()
@@ -732,7 +759,10 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 			{
 				if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor)
 				{
-					xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB);
+					scaleInBands(src->h, [&](int first, int last)
+					{
+						xbrz::scale(factor, (uint32_t*)src->pixels, (uint32_t*)dst->pixels, src->w, src->h, xbrz::RGB, xbrz::ScalerCfg(), first, last);
+					});
 					return 0;
 				}
 			}
@@ -752,19 +782,28 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 
 			if (dst->w == src->w * 2 && dst->h == src->h * 2)
 			{
-				hq2x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scaleInBands(src->h, [&](int first, int last)
+				{
+					hq2x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, first, last);
+				});
 				return 0;
 			}
 
 			if (dst->w == src->w * 3 && dst->h == src->h * 3)
 			{
-				hq3x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scaleInBands(src->h, [&](int first, int last)
+				{
+					hq3x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, first, last);
+				});
 				return 0;
 			}
 
 			if (dst->w == src->w * 4 && dst->h == src->h * 4)
 			{
-				hq4x_32_rb((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h);
+				scaleInBands(src->h, [&](int first, int last)
+				{
+					hq4x_32_rb_slice((uint32_t*)src->pixels, src->pitch, (uint32_t*)dst->pixels, dst->pitch, src->w, src->h, first, last);
+				});
 				return 0;
 			}
 		}
@@ -777,7 +816,10 @@ int Zoom::_zoomSurfaceY(SDL_Surface * src, SDL_Surface * dst, int flipx, int fli
 		{
 			if (dst->w == src->w * (int)factor && dst->h == src->h * (int)factor && !scale_precondition(factor, src->format->BytesPerPixel, src->w, src->h))
 			{
-				scale(factor, dst->pixels, dst->pitch, src->pixels, src->pitch, src->format->BytesPerPixel, src->w, src->h);
+				scaleInBands(src->h, [&](int first, int last)
+				{
+					scale_slice(factor, dst->pixels, dst->pitch, src->pixels, src->pitch, src->format->BytesPerPixel, src->w, src->h, first, last);
+				});
 				return 0;
 			}
 		}
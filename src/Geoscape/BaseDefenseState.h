@@ -55,6 +55,10 @@ public:
 	BaseDefenseState(Base *base, Ufo *ufo, GeoscapeState *state);
 	/// Cleans up the Base Defense state.
 	~BaseDefenseState();
+	/// Gets the attacked base.
+	Base *getBase() const { return _base; }
+	/// Gets the attacking UFO.
+	Ufo *getUfo() const { return _ufo; }
 	/// Handle the Timer.
 	void think() override;
 	/// do the next step.
@@ -169,6 +169,19 @@ void BaseDestroyedState::btnOkClick(Action *)
 		return;
 	}
 
+	removeBase();
+}
+
+/**
+ * Removes the destroyed base from the game, if it was destroyed completely.
+ */
+void BaseDestroyedState::removeBase()
+{
+	if (_partialDestruction)
+	{
+		return;
+	}
+
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		if ((*i) == _base)
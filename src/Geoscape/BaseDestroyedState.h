@@ -48,6 +48,8 @@ public:
 	~BaseDestroyedState();
 	/// Handler for clicking the Cydonia mission button.
 	void btnOkClick(Action *action);
+	/// Removes the destroyed base from the game.
+	void removeBase();
 
 };
 
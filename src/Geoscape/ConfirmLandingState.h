@@ -50,6 +50,8 @@ public:
 	ConfirmLandingState(Craft *craft, Texture *missionTexture, Texture *globeTexture, int shade);
 	/// Cleans up the Confirm Landing state.
 	~ConfirmLandingState();
+	/// Gets the craft that wants to land.
+	Craft *getCraft() const { return _craft; }
 	/// initialize the state, make a sanity check.
 	void init() override;
 	/// Handler for clicking the Yes button.
@@ -72,8 +72,6 @@ private:
 	bool _delayedRecolorDone;
 	// craft min/max, radar min/max, damage min/max, shield min/max
 	int _colors[13];
-	// Ends the dogfight.
-	void endDogfight();
 	bool _tractorLockedOn[RuleCraft::WeaponMax];
 
 public:
@@ -81,6 +79,8 @@ public:
 	DogfightState(GeoscapeState *state, Craft *craft, Ufo *ufo, bool ufoIsAttacking = false);
 	/// Cleans up the Dogfight state.
 	~DogfightState();
+	/// Ends the dogfight.
+	void endDogfight();
 	/// Returns true if this is a hunter-killer dogfight.
 	bool isUfoAttacking() const;
 	/// Runs the timers.
@@ -21,6 +21,10 @@
 #include <iomanip>
 #include <algorithm>
 #include <climits>
+#include <chrono>
+#include <iterator>
+#include <typeinfo>
+#include <yaml-cpp/yaml.h>
 #include <functional>
 #include "../Engine/RNG.h"
 #include "../Engine/Game.h"
@@ -33,6 +37,9 @@
 #include "../Engine/Options.h"
 #include "../Engine/Collections.h"
 #include "../Engine/Unicode.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Logger.h"
+#include "../Engine/LoadProfiler.h"
 #include "Globe.h"
 #include "../Interface/ComboBox.h"
 #include "../Interface/Text.h"
@@ -135,7 +142,8 @@ namespace OpenXcom
  * Initializes all the elements in the Geoscape screen.
  * @param game Pointer to the core game.
  */
-GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _minimizedDogfights(0), _slowdownCounter(0)
+GeoscapeState::GeoscapeState() : _pause(false), _zoomInEffectDone(false), _zoomOutEffectDone(false), _targetGrid(M_PI / 18), _minimizedDogfights(0), _slowdownCounter(0),
+	_simulation(!Options::simulateSave.empty()), _simulationGameOver(false)
 {
 	int screenWidth = Options::baseXGeoscape;
 	int screenHeight = Options::baseYGeoscape;
@@ -551,7 +559,7 @@ void GeoscapeState::handle(Action *action)
 						auto *item = _game->getMod()->getItem(itemRule);
 						if (item && item->isRecoverable() && !item->isAlien() && item->getSellCost() > 0)
 						{
-							base->getStorageItems()->addItem(itemRule, 2);
+							base->getStorageItems()->addItem(item, 2);
 						}
 					}
 				}
@@ -567,7 +575,7 @@ void GeoscapeState::handle(Action *action)
 						auto *item = _game->getMod()->getItem(itemRule);
 						if (item && item->isRecoverable() && item->isAlien() && item->getSellCost() > 0)
 						{
-							base->getStorageItems()->addItem(itemRule, 2);
+							base->getStorageItems()->addItem(item, 2);
 						}
 					}
 				}
@@ -714,6 +722,12 @@ void GeoscapeState::think()
 {
 	State::think();
 
+	if (_simulation)
+	{
+		runSimulation();
+		return;
+	}
+
 	_zoomInEffectTimer->think(this, 0);
 	_zoomOutEffectTimer->think(this, 0);
 	_dogfightStartTimer->think(this, 0);
@@ -886,6 +900,20 @@ const std::vector<Craft*>* GeoscapeState::updateActiveCrafts()
 	return &_activeCrafts;
 }
 
+/**
+ * Fills target grid with given targets, grid queries return them in same order.
+ * @param targets List of targets.
+ */
+template<typename T>
+void GeoscapeState::updateTargetGrid(const std::vector<T*> &targets)
+{
+	_targetGrid.clear();
+	for (auto target : targets)
+	{
+		_targetGrid.insert(target);
+	}
+}
+
 /**
  * Takes care of any game logic that has to
  * run every game second, like craft movement.
@@ -1465,6 +1493,7 @@ struct SetRetaliationTarget
  */
 void GeoscapeState::time10Minutes()
 {
+	updateTargetGrid(*_game->getSavedGame()->getAlienBases());
 	for (std::vector<Base*>::iterator i = _game->getSavedGame()->getBases()->begin(); i != _game->getSavedGame()->getBases()->end(); ++i)
 	{
 		// Fuel consumption for XCOM craft.
@@ -1497,13 +1526,15 @@ void GeoscapeState::time10Minutes()
 				if ((*j)->getDestination() == 0 && (*j)->getCraftStats().sightRange > 0)
 				{
 					double range = Nautical((*j)->getCraftStats().sightRange);
-					for (std::vector<AlienBase*>::iterator b = _game->getSavedGame()->getAlienBases()->begin(); b != _game->getSavedGame()->getAlienBases()->end(); ++b)
+					_targetGrid.query(*j, range, _nearTargets);
+					for (auto target : _nearTargets)
 					{
-						if ((*j)->getDistance(*b) <= range)
+						AlienBase *b = static_cast<AlienBase*>(target);
+						if ((*j)->getDistance(b) <= range)
 						{
-							if (RNG::percent(50-((*j)->getDistance(*b) / range) * 50) && !(*b)->isDiscovered())
+							if (RNG::percent(50-((*j)->getDistance(b) / range) * 50) && !b->isDiscovered())
 							{
-								(*b)->setDiscovered(true);
+								b->setDiscovered(true);
 							}
 						}
 					}
@@ -1511,14 +1542,26 @@ void GeoscapeState::time10Minutes()
 			}
 		}
 	}
+	// Only UFOs in sight range can detect base, grid skip all others.
+	double maxSightRange = 0.0;
+	for (auto ufo : *_game->getSavedGame()->getUfos())
+	{
+		maxSightRange = std::max(maxSightRange, Nautical(ufo->getCraftStats().sightRange));
+	}
+	updateTargetGrid(*_game->getSavedGame()->getUfos());
+	auto isBaseDetected = [&](Base *base)
+	{
+		// Find a UFO that detected this base, if any.
+		DetectXCOMBase detect(*base);
+		_targetGrid.query(base, maxSightRange, _nearTargets);
+		return std::any_of(_nearTargets.begin(), _nearTargets.end(), [&](Target *target) { return detect(static_cast<Ufo*>(target)); });
+	};
 	if (Options::aggressiveRetaliation)
 	{
 		// Detect as many bases as possible.
 		for (std::vector<Base*>::iterator iBase = _game->getSavedGame()->getBases()->begin(); iBase != _game->getSavedGame()->getBases()->end(); ++iBase)
 		{
-			// Find a UFO that detected this base, if any.
-			std::vector<Ufo*>::const_iterator uu = std::find_if (_game->getSavedGame()->getUfos()->begin(), _game->getSavedGame()->getUfos()->end(), DetectXCOMBase(**iBase));
-			if (uu != _game->getSavedGame()->getUfos()->end())
+			if (isBaseDetected(*iBase))
 			{
 				// Base found
 				(*iBase)->setRetaliationTarget(true);
@@ -1531,9 +1574,7 @@ void GeoscapeState::time10Minutes()
 		std::map<const Region *, Base *> discovered;
 		for (std::vector<Base*>::iterator iBase = _game->getSavedGame()->getBases()->begin(); iBase != _game->getSavedGame()->getBases()->end(); ++iBase)
 		{
-			// Find a UFO that detected this base, if any.
-			std::vector<Ufo*>::const_iterator uu = std::find_if (_game->getSavedGame()->getUfos()->begin(), _game->getSavedGame()->getUfos()->end(), DetectXCOMBase(**iBase));
-			if (uu != _game->getSavedGame()->getUfos()->end())
+			if (isBaseDetected(*iBase))
 			{
 				discovered[_game->getSavedGame()->locateRegion(**iBase)] = *iBase;
 			}
@@ -1551,7 +1592,7 @@ void GeoscapeState::time10Minutes()
 
 void GeoscapeState::ufoHuntingAndEscorting()
 {
-	auto crafts = updateActiveCrafts();
+	updateTargetGrid(*updateActiveCrafts());
 
 	for (std::vector<Ufo*>::iterator ufo = _game->getSavedGame()->getUfos()->begin(); ufo != _game->getSavedGame()->getUfos()->end(); ++ufo)
 	{
@@ -1574,9 +1615,11 @@ void GeoscapeState::ufoHuntingAndEscorting()
 				}
 			}
 
-			// look for more attractive target
-			for (auto craft : *crafts)
+			// look for more attractive target, only crafts near UFO can be in its radar range
+			_targetGrid.query(*ufo, Nautical((*ufo)->getCraftStats().radarRange), _nearTargets);
+			for (auto target : _nearTargets)
 			{
+				Craft *craft = static_cast<Craft*>(target);
 				if (!craft->getMissionComplete() && !craft->getRules()->isUndetectable())
 				{
 					int tmpAttraction = craft->getHunterKillerAttraction((*ufo)->getHuntMode());
@@ -1641,7 +1684,7 @@ void GeoscapeState::ufoHuntingAndEscorting()
 
 void GeoscapeState::baseHunting()
 {
-	auto crafts = updateActiveCrafts();
+	updateTargetGrid(*updateActiveCrafts());
 
 	for (std::vector<AlienBase*>::iterator ab = _game->getSavedGame()->getAlienBases()->begin(); ab != _game->getSavedGame()->getAlienBases()->end(); ++ab)
 	{
@@ -1655,8 +1698,10 @@ void GeoscapeState::baseHunting()
 			{
 				// Look for nearby craft
 				bool started = false;
-				for (auto craft : *crafts)
+				_targetGrid.query(*ab, Nautical((*ab)->getDeployment()->getBaseDetectionRange()), _nearTargets);
+				for (auto target : _nearTargets)
 				{
+					Craft *craft = static_cast<Craft*>(target);
 					// Craft is flying (i.e. not in base)
 					if (craft->getStatus() == "STR_OUT" && !craft->isDestroyed() && !craft->getRules()->isUndetectable())
 					{
@@ -1835,9 +1880,10 @@ void GeoscapeState::time30Minutes()
 				}
 				else
 				{
-					if (base->getStorageItems()->getItem(item) > 0)
+					const RuleItem *refuelItem = _game->getMod()->getItem(item);
+					if (base->getStorageItems()->getItem(refuelItem) > 0)
 					{
-						base->getStorageItems()->removeItem(item);
+						base->getStorageItems()->removeItem(refuelItem);
 						craft->refuel();
 						craft->setLowFuel(false);
 						// notification
@@ -2066,7 +2112,7 @@ void GeoscapeState::time1Hour()
 	{
 		for (std::vector<Transfer*>::iterator j = (*i)->getTransfers()->begin(); j != (*i)->getTransfers()->end(); ++j)
 		{
-			(*j)->advance(*i);
+			(*j)->advance(*i, _game->getMod());
 			if (!window && (*j)->getHours() <= 0)
 			{
 				window = true;
@@ -2106,10 +2152,9 @@ void GeoscapeState::time1Hour()
 			{
 				_game->getSavedGame()->setAlienContainmentChecked(true);
 				std::map<int, int> prisonTypes;
-				RuleItem *rule = nullptr;
-				for (auto &item : *(*i)->getStorageItems()->getContents())
+				for (auto &item : (*i)->getStorageItems()->getContents())
 				{
-					rule = _game->getMod()->getItem(item.first, true);
+					const RuleItem *rule = item.first;
 					if (rule->isAlien())
 					{
 						prisonTypes[rule->getPrisonType()] += 1;
@@ -2306,7 +2351,7 @@ void GeoscapeState::time1Day()
 					auto ruleCorpse = ruleUnit->getArmor()->getCorpseGeoscape();
 					if (ruleCorpse && ruleCorpse->isRecoverable() && ruleCorpse->isCorpseRecoverable())
 					{
-						base->getStorageItems()->addItem(ruleCorpse->getType());
+						base->getStorageItems()->addItem(ruleCorpse);
 					}
 				}
 			}
@@ -2742,6 +2787,11 @@ void GeoscapeState::time1Month()
  */
 void GeoscapeState::timerReset()
 {
+	if (_simulation)
+	{
+		// simulation keeps same speed all the time
+		return;
+	}
 	SDL_Event ev;
 	ev.button.button = SDL_BUTTON_LEFT;
 	Action act(&ev, _game->getScreen()->getXScale(), _game->getScreen()->getYScale(), _game->getScreen()->getCursorTopBlackBand(), _game->getScreen()->getCursorLeftBlackBand());
@@ -2756,6 +2806,11 @@ void GeoscapeState::timerReset()
  */
 void GeoscapeState::popup(State *state)
 {
+	if (_simulation)
+	{
+		resolveSimulationPopup(state);
+		return;
+	}
 	_pause = true;
 	_popups.push_back(state);
 }
@@ -3312,6 +3367,12 @@ void GeoscapeState::handleBaseDefense(Base *base, Ufo *ufo)
 	}
 	else if (base->getAvailableSoldiers(true, true) > 0 || !base->getVehicles()->empty())
 	{
+		if (_simulation)
+		{
+			// no battles in simulation, the garrison always wins
+			_simulationEvents["BaseDefenseBattle"] += 1;
+			return;
+		}
 		SavedBattleGame *bgame = new SavedBattleGame(_game->getMod(), _game->getLanguage());
 		_game->getSavedGame()->setBattleGame(bgame);
 		bgame->setMissionType("STR_BASE_DEFENSE");
@@ -3387,7 +3448,7 @@ void GeoscapeState::determineAlienMissions()
 					// item requirements
 					for (auto &triggerItem : arcScript->getItemTriggers())
 					{
-						triggerHappy = (save->isItemObtained(triggerItem.first) == triggerItem.second);
+						triggerHappy = (save->isItemObtained(triggerItem.first, mod) == triggerItem.second);
 						if (!triggerHappy)
 							break;
 					}
@@ -3510,7 +3571,7 @@ void GeoscapeState::determineAlienMissions()
 				// item requirements
 				for (auto &triggerItem : command->getItemTriggers())
 				{
-					triggerHappy = (save->isItemObtained(triggerItem.first) == triggerItem.second);
+					triggerHappy = (save->isItemObtained(triggerItem.first, mod) == triggerItem.second);
 					if (!triggerHappy)
 						break;
 				}
@@ -3611,7 +3672,7 @@ void GeoscapeState::determineAlienMissions()
 					// item requirements
 					for (auto &triggerItem : eventScript->getItemTriggers())
 					{
-						triggerHappy = (save->isItemObtained(triggerItem.first) == triggerItem.second);
+						triggerHappy = (save->isItemObtained(triggerItem.first, mod) == triggerItem.second);
 						if (!triggerHappy)
 							break;
 					}
@@ -4173,6 +4234,180 @@ void GeoscapeState::updateSlackingIndicator()
 	}
 }
 
+/**
+ * Fast-forwards the game by number of days given on command line, without drawing and without player.
+ * Popups are resolved by resolveSimulationPopup() and interceptions are broken off.
+ * Resulting game is saved as "SAVE_simulated.sav" next to the original save and time spent
+ * in each kind of game tick is written to "simulation_report.json" in user folder,
+ * next to the log file. Quits the game at end.
+ */
+void GeoscapeState::runSimulation()
+{
+	using Clock = std::chrono::steady_clock;
+	struct TickStats
+	{
+		const char *name;
+		void (GeoscapeState::*func)();
+		size_t count;
+		double seconds;
+	};
+	// indexed by TimeTrigger
+	TickStats ticks[] =
+	{
+		{ "5sec", &GeoscapeState::time5Seconds, 0, 0.0 },
+		{ "10min", &GeoscapeState::time10Minutes, 0, 0.0 },
+		{ "30min", &GeoscapeState::time30Minutes, 0, 0.0 },
+		{ "1hour", &GeoscapeState::time1Hour, 0, 0.0 },
+		{ "1day", &GeoscapeState::time1Day, 0, 0.0 },
+		{ "1month", &GeoscapeState::time1Month, 0, 0.0 },
+	};
+
+	SavedGame *save = _game->getSavedGame();
+	const int days = Options::simulateDays > 0 ? Options::simulateDays : 30;
+	_timeSpeed = _btn1Day;
+	_simulationEvents.clear();
+	_simulationGameOver = false;
+
+	Log(LOG_INFO) << "Simulating " << days << " days of " << Options::simulateSave;
+	std::string result = "finished";
+	int daysPassed = 0;
+	Clock::time_point start = Clock::now();
+	while (daysPassed < days)
+	{
+		// same order as in timeAdvance(), bigger triggers run all smaller ones too
+		TimeTrigger trigger = save->getTime()->advance();
+		for (int t = trigger; t >= TIME_5SEC; --t)
+		{
+			Clock::time_point tickStart = Clock::now();
+			(this->*ticks[t].func)();
+			ticks[t].count += 1;
+			ticks[t].seconds += std::chrono::duration<double>(Clock::now() - tickStart).count();
+		}
+		if (trigger >= TIME_1DAY)
+		{
+			++daysPassed;
+		}
+		resolveSimulationDogfights();
+
+		if (save->getBases()->empty())
+		{
+			result = "all bases lost";
+			break;
+		}
+		if (_simulationGameOver)
+		{
+			result = "game over in monthly report";
+			break;
+		}
+	}
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	Log(LOG_INFO) << "Simulation " << result << " after " << daysPassed << " days in " << seconds << " s";
+
+	std::string filename = CrossPlatform::noExt(Options::simulateSave) + "_simulated.sav";
+	try
+	{
+		save->save(filename, _game->getMod());
+		Log(LOG_INFO) << "Simulated game saved to " << filename;
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_ERROR) << "Failed to save simulated game: " << e.what();
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_ERROR) << "Failed to save simulated game: " << e.what();
+	}
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(6);
+	out << "{\n";
+	out << "  \"result\": \"" << result << "\",\n";
+	out << "  \"daysRequested\": " << days << ",\n";
+	out << "  \"daysSimulated\": " << daysPassed << ",\n";
+	out << "  \"seconds\": " << seconds << ",\n";
+	out << "  \"daysPerMinute\": " << (seconds > 0.0 ? daysPassed * 60.0 / seconds : 0.0) << ",\n";
+	out << "  \"ticks\": [\n";
+	for (int t = TIME_5SEC; t <= TIME_1MONTH; ++t)
+	{
+		out << "    {\"name\": \"" << ticks[t].name << "\", \"count\": " << ticks[t].count << ", \"seconds\": " << ticks[t].seconds << "}";
+		out << (t < TIME_1MONTH ? ",\n" : "\n");
+	}
+	out << "  ],\n";
+	out << "  \"events\": [\n";
+	for (auto i = _simulationEvents.begin(); i != _simulationEvents.end(); ++i)
+	{
+		out << "    {\"name\": \"" << i->first << "\", \"count\": " << i->second << "}";
+		out << (std::next(i) != _simulationEvents.end() ? ",\n" : "\n");
+	}
+	out << "  ]\n";
+	out << "}\n";
+
+	std::string reportname = Options::getUserFolder() + "simulation_report.json";
+	if (CrossPlatform::writeFile(reportname, out.str()))
+	{
+		Log(LOG_INFO) << "Simulation report written to " << reportname;
+	}
+	else
+	{
+		Log(LOG_WARNING) << "Failed to write simulation report: " << reportname;
+	}
+
+	_game->quit();
+}
+
+/**
+ * Resolves popup window without player, used by simulation.
+ * Windows that only inform are just closed, the rest get the default answer:
+ * crafts return to base instead of landing, base defenses go straight to
+ * handleBaseDefense() where the garrison always wins, and destroyed bases are removed.
+ * @param state Pointer to popup state, it is deleted here.
+ */
+void GeoscapeState::resolveSimulationPopup(State *state)
+{
+	_simulationEvents[LoadProfiler::getTypeName(typeid(*state))] += 1;
+	if (ConfirmLandingState *landing = dynamic_cast<ConfirmLandingState*>(state))
+	{
+		landing->getCraft()->returnToBase();
+	}
+	else if (BaseDefenseState *defense = dynamic_cast<BaseDefenseState*>(state))
+	{
+		handleBaseDefense(defense->getBase(), defense->getUfo());
+	}
+	else if (BaseDestroyedState *destroyed = dynamic_cast<BaseDestroyedState*>(state))
+	{
+		destroyed->removeBase();
+	}
+	else if (MonthlyReportState *report = dynamic_cast<MonthlyReportState*>(state))
+	{
+		_simulationGameOver = report->isGameOver();
+	}
+	delete state;
+}
+
+/**
+ * Breaks off all interceptions and sends the crafts home, used by simulation.
+ */
+void GeoscapeState::resolveSimulationDogfights()
+{
+	if (_dogfights.empty() && _dogfightsToBeStarted.empty())
+	{
+		return;
+	}
+	_dogfights.splice(_dogfights.end(), _dogfightsToBeStarted);
+	for (DogfightState *dogfight : _dogfights)
+	{
+		_simulationEvents["Dogfight"] += 1;
+		dogfight->endDogfight();
+		dogfight->getCraft()->returnToBase();
+	}
+	Collections::deleteAll(_dogfights);
+	_minimizedDogfights = 0;
+	_dogfightStartTimer->stop();
+	_dogfightTimer->stop();
+	_zoomInEffectTimer->stop();
+	_zoomOutEffectTimer->stop();
+}
+
 void GeoscapeState::cbxRegionChange(Action *)
 {
 	int index = _cbxRegion->getSelected();
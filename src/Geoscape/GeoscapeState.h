@@ -18,7 +18,9 @@
  * along with OpenXcom.  If not, see <http:///www.gnu.org/licenses/>.
  */
 #include "../Engine/State.h"
+#include "../Savegame/TargetGrid.h"
 #include <list>
+#include <map>
 
 namespace OpenXcom
 {
@@ -60,11 +62,18 @@ private:
 	std::list<State*> _popups;
 	std::list<DogfightState*> _dogfights, _dogfightsToBeStarted;
 	std::vector<Craft*> _activeCrafts;
+	TargetGrid _targetGrid;
+	std::vector<Target*> _nearTargets;
 	size_t _minimizedDogfights;
 	int _slowdownCounter;
+	bool _simulation, _simulationGameOver;
+	std::map<std::string, int> _simulationEvents;
 
 	/// Update list of active crafts.
 	const std::vector<Craft*>* updateActiveCrafts();
+	/// Fills target grid with given targets.
+	template<typename T>
+	void updateTargetGrid(const std::vector<T*> &targets);
 
 	void cbxRegionChange(Action *action);
 	void cbxZoneChange(Action *action);
@@ -186,6 +195,12 @@ private:
 	bool processCommand(RuleMissionScript *command);
 	bool buttonsDisabled();
 	void updateSlackingIndicator();
+	/// Fast-forwards the game without player.
+	void runSimulation();
+	/// Resolves popup without player.
+	void resolveSimulationPopup(State *state);
+	/// Breaks off all interceptions without player.
+	void resolveSimulationDogfights();
 };
 
 }
@@ -61,6 +61,7 @@ namespace OpenXcom
 
 const double Globe::ROTATE_LONGITUDE = 0.10;
 const double Globe::ROTATE_LATITUDE = 0.06;
+const double Globe::SHADOW_REDRAW_THRESHOLD = 0.002;
 
 Uint8 Globe::OCEAN_COLOR;
 bool Globe::OCEAN_SHADING;
@@ -324,7 +325,7 @@ struct CreateShadow
  * @param x X position in pixels.
  * @param y Y position in pixels.
  */
-Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _cenX(cenX), _cenY(cenY), _rotLon(0.0), _rotLat(0.0), _hoverLon(0.0), _hoverLat(0.0), _craftLon(0.0), _craftLat(0.0), _craftRange(0.0), _game(game), _hover(false), _craft(false), _blink(-1),
+Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y) : InteractiveSurface(width, height, x, y), _cenX(cenX), _cenY(cenY), _rotLon(0.0), _rotLat(0.0), _hoverLon(0.0), _hoverLat(0.0), _craftLon(0.0), _craftLat(0.0), _craftRange(0.0), _game(game), _hover(false), _craft(false), _shadowValid(false), _blink(-1),
 																					_isMouseScrolling(false), _isMouseScrolled(false), _xBeforeMouseScrolling(0), _yBeforeMouseScrolling(0), _lonBeforeMouseScrolling(0.0), _latBeforeMouseScrolling(0.0), _mouseScrollingStartTime(0), _totalMouseMoveX(0), _totalMouseMoveY(0), _mouseMovedOverThreshold(false)
 {
 	_rules = game->getMod()->getGlobe();
@@ -334,6 +335,7 @@ Globe::Globe(Game* game, int cenX, int cenY, int width, int height, int x, int y
 	_countries = new Surface(width, height, x, y);
 	_markers = new Surface(width, height, x, y);
 	_radars = new Surface(width, height, x, y);
+	_land = new Surface(width, height, x, y);
 	_clipper = new FastLineClip(x, x+width, y, y+height);
 
 	// Animation timers
@@ -365,6 +367,7 @@ Globe::~Globe()
 	delete _markers;
 	delete _texture;
 	delete _radars;
+	delete _land;
 	delete _clipper;
 
 	for (std::list<Polygon*>::iterator i = _cacheLand.begin(); i != _cacheLand.end(); ++i)
@@ -903,6 +906,7 @@ void Globe::setPalette(const SDL_Color *colors, int firstcolor, int ncolors)
 	_countries->setPalette(colors, firstcolor, ncolors);
 	_markers->setPalette(colors, firstcolor, ncolors);
 	_radars->setPalette(colors, firstcolor, ncolors);
+	_land->setPalette(colors, firstcolor, ncolors);
 }
 
 /**
@@ -940,19 +944,28 @@ void Globe::rotate()
 
 /**
  * Draws the whole globe, part by part.
+ * Ocean and land are kept in separate layer that is drawn again only
+ * when globe is moved, shadow is applied again only when the sun moved
+ * far enough to change it. Everything else is drawn on every call.
  */
 void Globe::draw()
 {
 	if (_redraw)
 	{
+		_redraw = false;
 		cachePolygons();
+		drawOcean();
+		drawLand();
+		_shadowValid = false;
+	}
+	Cord sunMove = getSunDirection(_cenLon, _cenLat);
+	sunMove -= _shadowSun;
+	if (!_shadowValid || sunMove.norm() > SHADOW_REDRAW_THRESHOLD)
+	{
+		drawShadow();
 	}
-	Surface::draw();
-	drawOcean();
-	drawLand();
 	drawRadars();
 	drawFlights();
-	drawShadow();
 	drawMarkers();
 	drawDetail();
 }
@@ -963,10 +976,11 @@ void Globe::draw()
  */
 void Globe::drawOcean()
 {
-	lock();
-	drawCircle(_cenX+1, _cenY, _radius+20, OCEAN_COLOR);
-//	ShaderDraw<Ocean>(ShaderSurface(this));
-	unlock();
+	_land->clear();
+	_land->lock();
+	_land->drawCircle(_cenX+1, _cenY, _radius+20, OCEAN_COLOR);
+//	ShaderDraw<Ocean>(ShaderSurface(_land));
+	_land->unlock();
 }
 
 
@@ -990,7 +1004,7 @@ void Globe::drawLand()
 		}
 
 		// Apply textures according to zoom and shade
-		drawTexturedPolygon(x, y, (*i)->getPoints(), _texture->getFrame((*i)->getTexture() + _zoomTexture), 0, 0);
+		_land->drawTexturedPolygon(x, y, (*i)->getPoints(), _texture->getFrame((*i)->getTexture() + _zoomTexture), 0, 0);
 	}
 }
 
@@ -1050,15 +1064,22 @@ Cord Globe::getSunDirection(double lon, double lat) const
 }
 
 
+/**
+ * Copies land layer to globe and shades it according to the time of day.
+ */
 void Globe::drawShadow()
 {
+	_shadowSun = getSunDirection(_cenLon, _cenLat);
+	_shadowValid = true;
+	copy(_land);
+
 	auto earth = ShaderMove<Cord>(SurfaceRaw<Cord>(_earthData[_zoom], getWidth(), getHeight()));
 	auto noise = ShaderRepeat<Sint16>(SurfaceRaw<Sint16>(static_data.random_noise, static_data.random_surf_size, static_data.random_surf_size));
 
 	earth.setMove(_cenX-getWidth()/2, _cenY-getHeight()/2);
 
 	lock();
-	ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(getSunDirection(_cenLon, _cenLat)), noise);
+	ShaderDraw<CreateShadow>(ShaderSurface(this), earth, ShaderScalar(_shadowSun), noise);
 	unlock();
 
 }
@@ -1269,7 +1290,7 @@ void Globe::drawGlobeCircle(double lat, double lon, double radius, int segments,
 			continue;
 		}
 		if (!pointBack(lon1,lat1) && i % frac == 0)
-			XuLine(_radars, this, x, y, x2, y2, 6);
+			XuLine(_radars, _land, x, y, x2, y2, 6);
 		x2=x; y2=y;
 		i++;
 	}
@@ -1597,7 +1618,7 @@ void Globe::drawPath(Surface *surface, double lon1, double lat1, double lon2, do
 
 		if (!pointBack(p1.lon, p1.lat) && !pointBack(p2.lon, p2.lat))
 		{
-			XuLine(surface, this, x1, y1, x2, y2, 8);
+			XuLine(surface, _land, x1, y1, x2, y2, 8);
 		}
 
 		p1 = p2;
@@ -1685,17 +1706,7 @@ void Globe::drawTarget(Target *target, Surface *surface)
 
 		if (i == CITY_MARKER || _blink > 0)
 		{
-			ShaderDrawFunc(
-				[](Uint8& destStuff, Uint8 srcStuff)
-				{
-					if (srcStuff)
-					{
-						destStuff = srcStuff;
-					}
-				},
-				dest,
-				surf
-			);
+			ShaderDraw<helper::MaskedCopy>(dest, surf);
 		}
 		else
 		{
@@ -2041,11 +2052,11 @@ void Globe::toggleRadarLines()
  */
 void Globe::resize()
 {
-	Surface *surfaces[4] = {this, _markers, _countries, _radars};
+	Surface *surfaces[5] = {this, _markers, _countries, _radars, _land};
 	int width = Options::baseXGeoscape - 64;
 	int height = Options::baseYGeoscape;
 
-	for (int i = 0; i < 4; ++i)
+	for (int i = 0; i < 5; ++i)
 	{
 		surfaces[i]->setWidth(width);
 		surfaces[i]->setHeight(height);
@@ -52,6 +52,7 @@ private:
 	static const int CITY_MARKER = 8;
 	static const double ROTATE_LONGITUDE;
 	static const double ROTATE_LATITUDE;
+	static const double SHADOW_REDRAW_THRESHOLD;
 
 	RuleGlobe *_rules;
 	Sint16 _cenX, _cenY;
@@ -60,8 +61,9 @@ private:
 	size_t _zoom, _zoomOld, _zoomTexture;
 	SurfaceSet *_texture, *_markerSet;
 	Game *_game;
-	Surface *_markers, *_countries, *_radars;
-	bool _hover, _craft;
+	Surface *_markers, *_countries, *_radars, *_land;
+	bool _hover, _craft, _shadowValid;
+	Cord _shadowSun;
 	int _blink;
 	Timer *_blinkTimer, *_rotTimer;
 	std::list<Polygon*> _cacheLand;
@@ -173,11 +175,11 @@ public:
 	void rotate();
 	/// Draws the whole globe.
 	void draw() override;
-	/// Draws the ocean of the globe.
+	/// Draws the ocean of the globe to land layer.
 	void drawOcean();
-	/// Draws the land of the globe.
+	/// Draws the land of the globe to land layer.
 	void drawLand();
-	/// Draws the shadow.
+	/// Draws the land layer with shadow.
 	void drawShadow();
 	/// Draws the radar ranges of the globe.
 	void drawRadars();
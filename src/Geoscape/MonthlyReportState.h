@@ -59,6 +59,8 @@ public:
 	void btnOkClick(Action *action);
 	/// Calculate monthly scores.
 	void calculateChanges();
+	/// Is the game lost because of the monthly report?
+	bool isGameOver() const { return _gameOver != 0; }
 };
 
 }
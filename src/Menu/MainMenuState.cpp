@@ -35,7 +35,11 @@
 #include "../Engine/Options.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/SDL2Helpers.h"
+#include "../Engine/Logger.h"
+#include "../Geoscape/GeoscapeState.h"
+#include "../Savegame/SavedGame.h"
 #include <fstream>
+#include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
 {
@@ -199,13 +203,54 @@ MainMenuState::MainMenuState(bool updateCheck)
 void MainMenuState::init()
 {
 	State::init();
-	if (Options::getLoadLastSave() && _game->getSavedGame()->getList(_game->getLanguage(), true).size() > 0)
+	if (!Options::simulateSave.empty())
+	{
+		startSimulation();
+	}
+	else if (Options::getLoadLastSave() && _game->getSavedGame()->getList(_game->getLanguage(), true).size() > 0)
 	{
 		Log(LOG_INFO) << "Loading last saved game";
 		btnLoadClick(NULL);
 	}
 }
 
+/**
+ * Loads the save given on command line and lets the Geoscape
+ * fast-forward it without player, quits on any error.
+ */
+void MainMenuState::startSimulation()
+{
+	Log(LOG_INFO) << "Simulating saved game " << Options::simulateSave;
+	SavedGame *s = new SavedGame();
+	try
+	{
+		s->load(Options::simulateSave, _game->getMod(), _game->getLanguage());
+		if (s->getSavedBattle() != 0 || s->getEnding() != END_NONE)
+		{
+			throw Exception("Only Geoscape saves of running games can be simulated");
+		}
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_ERROR) << "Simulation failed: " << e.what();
+		delete s;
+		_game->quit();
+		return;
+	}
+	catch (YAML::Exception &e)
+	{
+		Log(LOG_ERROR) << "Simulation failed: " << e.what();
+		delete s;
+		_game->quit();
+		return;
+	}
+	_game->setSavedGame(s);
+	Options::baseXResolution = Options::baseXGeoscape;
+	Options::baseYResolution = Options::baseYGeoscape;
+	_game->getScreen()->resetDisplay(false);
+	_game->setState(new GeoscapeState);
+}
+
 /**
  *
  */
@@ -51,6 +51,8 @@ private:
 	bool _debugInVisualStudio;
 	std::string _newVersion;
 #endif
+	/// Loads the save given on command line and simulates it.
+	void startSimulation();
 public:
 	/// Creates the Main Menu state.
 	MainMenuState(bool updateCheck = false);
@@ -23,6 +23,7 @@
 #include "../Engine/SurfaceSet.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/Logger.h"
+#include "../Engine/Options.h"
 #include "../Engine/Exception.h"
 #include "../Engine/Unicode.h"
 #include "Mod.h"
@@ -241,7 +242,7 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 					continue;
 				try
 				{
-					getFrame(set, offset)->loadImage(fileName + *k);
+					loadFrame(set, offset, fileName + *k);
 					offset++;
 				}
 				catch (Exception &e)
@@ -254,7 +255,7 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 		{
 			if (!subdivision)
 			{
-				getFrame(set, startFrame)->loadImage(fileName);
+				loadFrame(set, startFrame, fileName);
 			}
 			else
 			{
@@ -282,7 +283,13 @@ SurfaceSet *ExtraSprites::loadSurfaceSet(SurfaceSet *set)
 	return set;
 }
 
-Surface *ExtraSprites::getFrame(SurfaceSet *set, int index) const
+/**
+ * Gets index in surface set that frame of this mod is stored at.
+ * @param set Surface set.
+ * @param index Frame number as defined by mod.
+ * @return Index in surface set.
+ */
+int ExtraSprites::getFrameIndex(SurfaceSet *set, int index) const
 {
 	int indexWithOffset = index;
 	if (indexWithOffset >= set->getMaxSharedFrames())
@@ -301,7 +308,18 @@ Surface *ExtraSprites::getFrame(SurfaceSet *set, int index) const
 		err << "ExtraSprites '" << _type << "' frame '" << indexWithOffset << "' in mod '" << _current->name << "' is not allowed.";
 		throw Exception(err.str());
 	}
+	return indexWithOffset;
+}
 
+/**
+ * Gets cleared frame of surface set, frame is created if needed.
+ * @param set Surface set.
+ * @param index Frame number as defined by mod.
+ * @return Frame surface.
+ */
+Surface *ExtraSprites::getFrame(SurfaceSet *set, int index) const
+{
+	int indexWithOffset = getFrameIndex(set, index);
 	Surface *frame = set->getFrame(indexWithOffset);
 	if (frame)
 	{
@@ -316,4 +334,25 @@ Surface *ExtraSprites::getFrame(SurfaceSet *set, int index) const
 	return frame;
 }
 
+/**
+ * Loads frame of surface set from an image file.
+ * With lazy loading, the image is only read when frame is first used.
+ * @param set Surface set.
+ * @param index Frame number as defined by mod.
+ * @param fileName Image filename.
+ */
+void ExtraSprites::loadFrame(SurfaceSet *set, int index, const std::string &fileName) const
+{
+	if (Options::lazyLoadResources)
+	{
+		int indexWithOffset = getFrameIndex(set, index);
+		Log(LOG_VERBOSE) << "Adding lazy frame: " << index << ", using index: " << indexWithOffset;
+		set->addLazyFrame(indexWithOffset, fileName);
+	}
+	else
+	{
+		getFrame(set, index)->loadImage(fileName);
+	}
+}
+
 }
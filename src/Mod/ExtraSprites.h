@@ -42,7 +42,9 @@ private:
 	int _subX, _subY;
 	bool _loaded;
 
+	int getFrameIndex(SurfaceSet *set, int index) const;
 	Surface *getFrame(SurfaceSet *set, int index) const;
+	void loadFrame(SurfaceSet *set, int index, const std::string &fileName) const;
 public:
 	/// Creates a blank external sprite set.
 	ExtraSprites();
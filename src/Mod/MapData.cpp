@@ -28,11 +28,12 @@ namespace OpenXcom
 MapData::MapData(MapDataSet *dataset) : _dataset(dataset), _specialType(TILE), 
 				_isUfoDoor(false), _stopLOS(false), _isNoFloor(false), _isGravLift(false), _isDoor(false), _blockFire(false), _blockSmoke(false), _baseModule(false),
 				_yOffset(0), _TUWalk(0), _TUFly(0), _TUSlide(0), _terrainLevel(0), _footstepSound(0), _dieMCD(0), _altMCD(0), _objectType(O_FLOOR), _lightSource(0),
-				_armor(0), _flammable(0), _fuel(0), _explosive(0), _explosiveType(0), _bigWall(0), _miniMapIndex(0)
+				_armor(0), _flammable(0), _fuel(0), _explosive(0), _explosiveType(0), _bigWall(0), _voxelLayers(0), _miniMapIndex(0)
 {
 	std::fill_n(_sprite, 8, 0);
 	std::fill_n(_block, 6, 0);
 	std::fill_n(_loftID, 12, 0);
+	std::fill_n(&_voxels[0][0], 12 * 16, 0);
 }
 
 /**
@@ -465,6 +466,36 @@ void MapData::setLoftID(int loft, int layer)
 	_loftID[layer] = loft;
 }
 
+/**
+ * Copies the voxel rows referenced by the loft indexes into this object,
+ * so voxel checks do not need to go through LOFTEMPS each time.
+ * @param voxelData The LOFTEMPS voxel data.
+ * @return False if some loft index is outside of the voxel data.
+ */
+bool MapData::buildVoxels(const std::vector<Uint16> *voxelData)
+{
+	bool valid = true;
+	_voxelLayers = 0;
+	for (int layer = 0; layer < 12; ++layer)
+	{
+		size_t idx = (size_t)_loftID[layer] * 16;
+		bool inRange = voxelData && _loftID[layer] >= 0 && idx + 16 <= voxelData->size();
+		if (!inRange)
+		{
+			valid = false;
+		}
+		for (int y = 0; y < 16; ++y)
+		{
+			_voxels[layer][y] = inRange ? (*voxelData)[idx + y] : 0;
+			if (_voxels[layer][y])
+			{
+				_voxelLayers |= (1 << layer);
+			}
+		}
+	}
+	return valid;
+}
+
 /**
  * Gets the amount of explosive.
  * @return The amount of explosive.
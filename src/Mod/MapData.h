@@ -62,6 +62,8 @@ private:
 	int _sprite[8];
 	int _block[6];
 	int _loftID[12];
+	Uint16 _voxels[12][16];
+	Uint16 _voxelLayers;
 	unsigned short _miniMapIndex;
 public:
 	static const int O_DUMMY = 999;
@@ -145,6 +147,30 @@ public:
 	int getLoftID(int layer) const;
 	/// Sets the loft index for a certain layer.
 	void setLoftID(int loft, int layer);
+	/// Builds the voxel occupancy bitset from the loft indexes.
+	bool buildVoxels(const std::vector<Uint16> *voxelData);
+
+	/**
+	 * Checks if a voxel of this object is solid.
+	 * @param x X coordinate inside the tile (0-15).
+	 * @param y Y coordinate inside the tile (0-15).
+	 * @param layer Loft layer (0-11), each layer is 2 voxels high.
+	 * @return True if voxel is occupied.
+	 */
+	bool isVoxelSolid(int x, int y, int layer) const
+	{
+		return _voxels[layer][y] & (1 << (15 - x));
+	}
+
+	/**
+	 * Gets the mask of loft layers that have at least one solid voxel.
+	 * @return Bit mask, one bit per layer.
+	 */
+	Uint16 getVoxelLayers() const
+	{
+		return _voxelLayers;
+	}
+
 	/// Gets the amount of explosive.
 	int getExplosive() const;
 	/// Sets the amount of explosive.
@@ -33,8 +33,10 @@ MapData *MapDataSet::_scorchedTile = 0;
 
 /**
  * MapDataSet construction.
+ * @param name Name of the MCD file.
+ * @param voxelData LOFTEMPS voxel data used to build the voxel bitsets of objects.
  */
-MapDataSet::MapDataSet(const std::string &name) : _name(name), _surfaceSet(0), _loaded(false)
+MapDataSet::MapDataSet(const std::string &name, const std::vector<Uint16> *voxelData) : _name(name), _surfaceSet(0), _voxelData(voxelData), _loaded(false)
 {
 }
 
@@ -222,6 +224,15 @@ void MapDataSet::loadData(MCDPatch *patch, bool validate)
 		patch->modifyData(this);
 	}
 
+	// voxel bitsets need final loft indexes, so build them after patching
+	for (size_t i = 0; i < _objects.size(); ++i)
+	{
+		if (!_objects[i]->buildVoxels(_voxelData) && _voxelData && !_voxelData->empty())
+		{
+			Log(LOG_INFO) << "MCD " << _name << " object " << i << " has invalid LOFT index";
+		}
+	}
+
 	// Validate MCD references
 	if (validate)
 	{
@@ -41,11 +41,12 @@ private:
 	std::string _name;
 	std::vector<MapData*> _objects;
 	SurfaceSet *_surfaceSet;
+	const std::vector<Uint16> *_voxelData;
 	bool _loaded;
 	static MapData *_blankTile;
 	static MapData *_scorchedTile;
 public:
-	MapDataSet(const std::string &name);
+	MapDataSet(const std::string &name, const std::vector<Uint16> *voxelData = nullptr);
 	~MapDataSet();
 	/// Loads voxeldata from a DAT file.
 	static void loadLOFTEMPS(const std::string &filename, std::vector<Uint16> *voxelData);
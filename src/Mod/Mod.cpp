@@ -23,9 +23,15 @@
 #include <climits>
 #include <unordered_map>
 #include <cassert>
+#include <exception>
+#include <iterator>
+#include <memory>
 #include "../Engine/CrossPlatform.h"
 #include "../Engine/FileMap.h"
 #include "../Engine/SDL2Helpers.h"
+#include "../Engine/ThreadPool.h"
+#include "../Engine/LoadProfiler.h"
+#include "../Engine/StringId.h"
 #include "../Engine/Palette.h"
 #include "../Engine/Font.h"
 #include "../Engine/Surface.h"
@@ -106,6 +112,7 @@
 #include "RuleConverter.h"
 #include "RuleSoldierTransformation.h"
 #include "RuleSoldierBonus.h"
+#include "RulesetCache.h"
 
 #define ARRAYLEN(x) (std::size(x))
 
@@ -1616,6 +1623,7 @@ static void throwModOnErrorHelper(const std::string& modId, const std::string& e
  */
 void Mod::loadAll()
 {
+	LoadProfiler::Scope profileAll("phase", "loadAll");
 	ModScript parser{ _scriptGlobal, this };
 	auto mods = FileMap::getRulesets();
 
@@ -1658,15 +1666,20 @@ void Mod::loadAll()
 			auto file = FileMap::getModRuleFile(_modCurrent->info, _modCurrent->info->getResourceConfigFile());
 			if (file)
 			{
+				LoadProfiler::Scope profile("resourceConfig", _modCurrent->name);
 				loadResourceConfigFile(*file);
 			}
 		}
 	}
+	LoadProfiler::endLap();
 
 	Log(LOG_INFO) << "Loading vanilla resources...";
 	// vanilla resources load
 	_modCurrent = &_modData.at(0);
-	loadVanillaResources();
+	{
+		LoadProfiler::Scope profile("phase", "vanillaResources");
+		loadVanillaResources();
+	}
 	_surfaceOffsetBasebits = _sets["BASEBITS.PCK"]->getMaxSharedFrames();
 	_surfaceOffsetBigobs = _sets["BIGOBS.PCK"]->getMaxSharedFrames();
 	_surfaceOffsetFloorob = _sets["FLOOROB.PCK"]->getMaxSharedFrames();
@@ -1678,6 +1691,11 @@ void Mod::loadAll()
 	_soundOffsetGeo = _sounds["GEO.CAT"]->getMaxSharedSounds();
 
 	Log(LOG_INFO) << "Loading rulesets...";
+	std::unique_ptr<RulesetCache> cache;
+	if (Options::oxceRulesetCache)
+	{
+		cache = std::make_unique<RulesetCache>(Options::getMasterUserFolder() + "ruleset.cache");
+	}
 	// load rest rulesets
 	for (size_t i = 0; mods.size() > i; ++i)
 	{
@@ -1685,14 +1703,24 @@ void Mod::loadAll()
 		{
 			_modCurrent = &_modData.at(i);
 			_scriptGlobal->setMod((int)_modCurrent->offset);
-			loadMod(mods[i].second, parser);
+			LoadProfiler::Scope profile("mod", _modCurrent->name);
+			loadMod(mods[i].second, parser, cache.get());
 		}
 		catch (Exception &e)
 		{
+			if (cache)
+			{
+				// cached files do not have line numbers, next try will report error with them
+				cache->discard();
+			}
 			const std::string &modId = mods[i].first;
 			throwModOnErrorHelper(modId, e.what());
 		}
 	}
+	if (cache)
+	{
+		cache->save();
+	}
 	Log(LOG_INFO) << "Loading rulesets done.";
 
 	//back master
@@ -1737,6 +1765,15 @@ void Mod::loadAll()
 		}
 	}
 
+	// dense indexes of items for ItemContainer, in order of item types like in saves
+	{
+		int index = 0;
+		for (auto& i : _items)
+		{
+			i.second->setIndex(index++);
+		}
+	}
+
 	// cross link rule objects
 
 	afterLoadHelper("research", this, _research, &RuleResearch::afterLoad);
@@ -1868,8 +1905,15 @@ void Mod::loadAll()
 	Log(LOG_INFO) << "Loading ended.";
 
 	sortLists();
-	loadExtraResources();
-	modResources();
+	linkResearchReverse();
+	{
+		LoadProfiler::Scope profile("phase", "extraResources");
+		loadExtraResources();
+	}
+	{
+		LoadProfiler::Scope profile("phase", "modResources");
+		modResources();
+	}
 }
 
 /**
@@ -1877,19 +1921,84 @@ void Mod::loadAll()
  * mod loaded should be the master at index 0, then 1, and so on.
  * @param rulesetFiles List of rulesets to load.
  * @param parsers Object with all available parsers.
- */
-void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers)
-{
-	for (auto i = rulesetFiles.begin(); i != rulesetFiles.end(); ++i)
+ * @param cache Cache of parsed files, can be null.
+ */
+void Mod::loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers, RulesetCache *cache)
+{
+	// parsing YAML is the slow part and files are independent of each other, so it is done first for all files at once,
+	// reading files from disk or zip is not thread safe and stays on main thread.
+	const int count = (int)rulesetFiles.size();
+	std::vector<std::string> contents(count);
+	std::vector<std::string> keys(count);
+	std::vector<std::string> serialized(count);
+	std::vector<char> cached(count, false);
+	std::vector<YAML::Node> docs(count);
+	std::vector<std::exception_ptr> errors(count);
+	for (int i = 0; i < count; ++i)
+	{
+		LoadProfiler::Scope profile("fileRead", rulesetFiles[i].fullpath);
+		auto stream = rulesetFiles[i].getIStream();
+		contents[i].assign(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+	}
+	ThreadPool::parallelFor(count,
+		[&](int i)
+		{
+			LoadProfiler::Scope profile("fileParse", rulesetFiles[i].fullpath);
+			try
+			{
+				if (cache)
+				{
+					keys[i] = RulesetCache::getKey(contents[i]);
+					cached[i] = cache->find(keys[i], docs[i]);
+				}
+				if (!cached[i])
+				{
+					docs[i] = YAML::Load(contents[i]);
+					if (cache)
+					{
+						serialized[i] = RulesetCache::serialize(docs[i]);
+					}
+				}
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+			contents[i] = std::string();
+		}
+	);
+
+	// rules are applied in original order, so overriding between files works the same as before.
+	for (int i = 0; i < count; ++i)
 	{
-		Log(LOG_VERBOSE) << "- " << i->fullpath;
+		const auto &filerec = rulesetFiles[i];
+		Log(LOG_VERBOSE) << "- " << filerec.fullpath << (cached[i] ? " (cached)" : "");
 		try
 		{
-			loadFile(*i, parsers);
+			if (errors[i])
+			{
+				Log(LOG_FATAL) << "Error loading file '" << filerec.fullpath << "'";
+				std::rethrow_exception(errors[i]);
+			}
+			LoadProfiler::Scope profile("fileApply", filerec.fullpath);
+			loadFile(docs[i], parsers);
+			LoadProfiler::endLap();
+			docs[i] = YAML::Node();
 		}
 		catch (YAML::Exception &e)
 		{
-			throw Exception(i->fullpath + ": " + std::string(e.what()));
+			throw Exception(filerec.fullpath + ": " + std::string(e.what()));
+		}
+		if (cache)
+		{
+			if (cached[i])
+			{
+				cache->use(keys[i]);
+			}
+			else
+			{
+				cache->add(keys[i], std::move(serialized[i]));
+			}
 		}
 	}
 
@@ -2043,13 +2152,11 @@ void Mod::loadConstants(const YAML::Node &node)
 /**
  * Loads a ruleset's contents from a YAML file.
  * Rules that match pre-existing rules overwrite them.
- * @param filename YAML filename.
+ * @param doc Parsed YAML file.
  * @param parsers Object with all available parsers.
  */
-void Mod::loadFile(const FileMap::FileRecord &filerec, ModScript &parsers)
+void Mod::loadFile(YAML::Node &doc, ModScript &parsers)
 {
-	auto doc = filerec.getYAML();
-
 	if (const YAML::Node &extended = doc["extended"])
 	{
 		_scriptGlobal->load(extended);
@@ -2815,6 +2922,11 @@ static void refNodeTestDeepth(const YAML::Node &node, const std::string &name, i
 template <typename T>
 T *Mod::loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::vector<std::string> *index, const std::string &key) const
 {
+	if (LoadProfiler::isEnabled())
+	{
+		// time up to next rule of other type goes to this type, this covers `rule->load()` done by caller
+		LoadProfiler::lap("rule", LoadProfiler::getTypeName(typeid(T)));
+	}
 	T *rule = 0;
 	if (node[key])
 	{
@@ -2828,6 +2940,8 @@ T *Mod::loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::ve
 		{
 			rule = new T(type);
 			(*map)[type] = rule;
+			// names of rules get first IDs, so arrays indexed by them stay small
+			StringId::intern(type);
 			if (index != 0)
 			{
 				index->push_back(type);
@@ -3232,7 +3346,7 @@ MapDataSet *Mod::getMapDataSet(const std::string &name)
 	std::map<std::string, MapDataSet*>::iterator map = _mapDataSets.find(name);
 	if (map == _mapDataSets.end())
 	{
-		MapDataSet *set = new MapDataSet(name);
+		MapDataSet *set = new MapDataSet(name, &_voxelData);
 		_mapDataSets[name] = set;
 		return set;
 	}
@@ -4025,6 +4139,125 @@ void Mod::sortLists()
 	std::sort(_soldiersIndex.begin(), _soldiersIndex.end(), compareRule<RuleSoldier>(this, (compareRule<RuleSoldier>::RuleLookup) & Mod::getSoldier));
 }
 
+namespace
+{
+
+/**
+ * Adds rule to reverse link list, skips it when rule refers to same topic more than once.
+ */
+template<typename T>
+void addReverseLink(std::vector<T*> &list, T *rule)
+{
+	if (list.empty() || list.back() != rule)
+	{
+		list.push_back(rule);
+	}
+}
+
+}
+
+/**
+ * Links all research topics with rules that refer to them.
+ * It allows to find what completed research can make available without scanning all rules.
+ * Need to be called after sortLists(), links are stored in list order.
+ */
+void Mod::linkResearchReverse()
+{
+	auto links = [&](const RuleResearch *r) -> RuleResearchReverseLinks&
+	{
+		return getResearch(r->getName(), true)->getReverseLinks();
+	};
+
+	for (auto& r : _research)
+	{
+		r.second->getReverseLinks() = RuleResearchReverseLinks{};
+	}
+
+	for (auto& name : _researchIndex)
+	{
+		const RuleResearch *rule = getResearch(name, true);
+		for (auto& i : rule->getDependencies())
+		{
+			addReverseLink(links(i).leadsTo, rule);
+		}
+		for (auto& i : rule->getRequirements())
+		{
+			addReverseLink(links(i).requiredByResearch, rule);
+		}
+		for (auto& i : rule->getUnlocked())
+		{
+			addReverseLink(links(i).unlockedBy, rule);
+		}
+		for (auto& i : rule->getDisabled())
+		{
+			addReverseLink(links(i).disabledBy, rule);
+		}
+		for (auto& i : rule->getGetOneFree())
+		{
+			addReverseLink(links(i).getOneFreeFrom, rule);
+		}
+		for (auto& itMap : rule->getGetOneFreeProtected())
+		{
+			for (auto& i : itMap.second)
+			{
+				addReverseLink(links(i).getOneFreeFrom, rule);
+			}
+		}
+		if (!rule->getLookup().empty())
+		{
+			RuleResearch *lookup = getResearch(rule->getLookup(), false);
+			if (lookup)
+			{
+				addReverseLink(lookup->getReverseLinks().lookupOf, rule);
+			}
+		}
+	}
+	for (auto& name : _manufactureIndex)
+	{
+		RuleManufacture *rule = getManufacture(name, true);
+		for (auto& i : rule->getRequirements())
+		{
+			addReverseLink(links(i).requiredByManufacture, rule);
+		}
+	}
+	for (auto& name : _itemsIndex)
+	{
+		RuleItem *rule = getItem(name, true);
+		for (auto& i : rule->getRequirements())
+		{
+			addReverseLink(links(i).requiredByItems, rule);
+		}
+		for (auto& i : rule->getBuyRequirements())
+		{
+			addReverseLink(links(i).requiredByItems, rule);
+		}
+	}
+	for (auto& name : _craftsIndex)
+	{
+		RuleCraft *rule = getCraft(name, true);
+		for (auto& i : rule->getRequirements())
+		{
+			RuleResearch *research = getResearch(i, false);
+			if (research)
+			{
+				addReverseLink(research->getReverseLinks().requiredByCrafts, rule);
+			}
+		}
+	}
+	for (auto& name : _facilitiesIndex)
+	{
+		RuleBaseFacility *rule = getBaseFacility(name, true);
+		for (auto& i : rule->getRequirements())
+		{
+			RuleResearch *research = getResearch(i, false);
+			if (research)
+			{
+				addReverseLink(research->getReverseLinks().requiredByFacilities, rule);
+			}
+		}
+	}
+}
+
 /**
  * Gets the research-requirements for Psi-Lab (it's a cache for psiStrengthEval)
  */
@@ -5028,6 +5261,7 @@ void Mod::loadExtraResources()
 		MusicFormat priority[] = { Options::preferredMusic, MUSIC_FLAC, MUSIC_OGG, MUSIC_MP3, MUSIC_MOD, MUSIC_WAV, MUSIC_ADLIB, MUSIC_GM, MUSIC_MIDI };
 		for (std::map<std::string, RuleMusic *>::const_iterator i = _musicDefs.begin(); i != _musicDefs.end(); ++i)
 		{
+			LoadProfiler::Scope profile("music", (*i).first);
 			Music *music = 0;
 			for (size_t j = 0; j < ARRAYLEN(priority) && music == 0; ++j)
 			{
@@ -5066,6 +5300,7 @@ void Mod::loadExtraResources()
 			std::string setName = i->first;
 			ExtraSounds *soundPack = i->second;
 			SoundSet *set = 0;
+			LoadProfiler::Scope profile("sounds", setName);
 
 			std::map<std::string, SoundSet*>::iterator j = _sounds.find(setName);
 			if (j != _sounds.end())
@@ -5166,6 +5401,8 @@ void Mod::loadExtraSprite(ExtraSprites *spritePack)
 	if (spritePack->isLoaded())
 		return;
 
+	LoadProfiler::Scope profile("sprites", spritePack->getType());
+
 	if (spritePack->getSingleImage())
 	{
 		Surface *surface = 0;
@@ -71,6 +71,7 @@ class RuleManufacture;
 class RuleManufactureShortcut;
 class RuleSoldierBonus;
 class RuleSoldierTransformation;
+class RulesetCache;
 class AlienRace;
 class RuleEnviroEffects;
 class RuleStartingCondition;
@@ -125,7 +126,7 @@ struct ModData
  */
 struct LoadRuleException : Exception
 {
-	LoadRuleException(const std::string& parent, const YAML::Node &node, const std::string& message) : Exception{ "Error for '" + parent + "': " + message + " at line " + std::to_string(node.Mark().line)}
+	LoadRuleException(const std::string& parent, const YAML::Node &node, const std::string& message) : Exception{ "Error for '" + parent + "': " + message + (node.Mark().is_null() ? std::string(" at unknown line (file loaded from ruleset cache)") : " at line " + std::to_string(node.Mark().line))}
 	{
 
 	}
@@ -299,8 +300,8 @@ private:
 	/// Loads a ruleset from a YAML file that have basic resources configuration.
 	void loadResourceConfigFile(const FileMap::FileRecord &filerec);
 	void loadConstants(const YAML::Node &node);
-	/// Loads a ruleset from a YAML file.
-	void loadFile(const FileMap::FileRecord &filerec, ModScript &parsers);
+	/// Loads a ruleset from a parsed YAML file.
+	void loadFile(YAML::Node &doc, ModScript &parsers);
 	/// Loads a ruleset element.
 	template <typename T>
 	T *loadRule(const YAML::Node &node, std::map<std::string, T*> *map, std::vector<std::string> *index = 0, const std::string &key = "type") const;
@@ -318,7 +319,7 @@ private:
 	/// Creates a transparency lookup table for a given palette.
 	void createTransparencyLUT(Palette *pal);
 	/// Loads a specified mod content.
-	void loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers);
+	void loadMod(const std::vector<FileMap::FileRecord> &rulesetFiles, ModScript &parsers, RulesetCache *cache);
 	/// Loads resources from vanilla.
 	void loadVanillaResources();
 	/// Loads resources from extra rulesets.
@@ -331,6 +332,8 @@ private:
 	void modResources();
 	/// Sorts all our lists according to their weight.
 	void sortLists();
+	/// Links research topics with rules that refer to them.
+	void linkResearchReverse();
 public:
 	static int DOOR_OPEN;
 	static int SLIDING_DOOR_OPEN;
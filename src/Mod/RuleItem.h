@@ -296,6 +296,7 @@ private:
 	std::vector<std::string> _categories;
 
 	Unit* _vehicleUnit;
+	int _index;
 	double _size;
 	int _costBuy, _costSell, _transferTime, _weight;
 	int _throwRange, _underwaterThrowRange;
@@ -412,6 +413,10 @@ public:
 
 	/// Gets the item's type.
 	const std::string &getType() const;
+	/// Gets the item's index in list of all items.
+	int getIndex() const { return _index; }
+	/// Sets the item's index in list of all items.
+	void setIndex(int index) { _index = index; }
 	/// Gets the item's name.
 	const std::string &getName() const;
 	/// Gets the item's name when loaded in weapon.
@@ -22,11 +22,45 @@
 #include <yaml-cpp/yaml.h>
 #include "RuleBaseFacilityFunctions.h"
 #include "ModScript.h"
+#include "../Engine/StringId.h"
 
 namespace OpenXcom
 {
 
 class Mod;
+class RuleResearch;
+class RuleManufacture;
+class RuleItem;
+class RuleCraft;
+class RuleBaseFacility;
+
+/**
+ * Reverse links of research topic, all rules that refer to it.
+ * Filled by Mod after all rules are loaded, every list is in list order.
+ */
+struct RuleResearchReverseLinks
+{
+	/// Topics that have this one in dependencies.
+	std::vector<const RuleResearch*> leadsTo;
+	/// Topics that have this one in requirements.
+	std::vector<const RuleResearch*> requiredByResearch;
+	/// Topics that unlock this one.
+	std::vector<const RuleResearch*> unlockedBy;
+	/// Topics that disable this one.
+	std::vector<const RuleResearch*> disabledBy;
+	/// Topics that give this one for free.
+	std::vector<const RuleResearch*> getOneFreeFrom;
+	/// Topics that use this one as lookup.
+	std::vector<const RuleResearch*> lookupOf;
+	/// Manufacture projects that require this topic.
+	std::vector<RuleManufacture*> requiredByManufacture;
+	/// Items that require this topic, for use or for purchase.
+	std::vector<RuleItem*> requiredByItems;
+	/// Crafts that require this topic.
+	std::vector<RuleCraft*> requiredByCrafts;
+	/// Facilities that require this topic.
+	std::vector<RuleBaseFacility*> requiredByFacilities;
+};
 
 /**
  * Represents one research project.
@@ -44,6 +78,7 @@ class RuleResearch
 {
  private:
 	std::string _name, _lookup, _cutscene, _spawnedItem, _spawnedEvent;
+	StringId _id;
 	int _cost, _points;
 	std::vector<std::string> _dependenciesName, _unlocksName, _disablesName, _getOneFreeName, _requiresName;
 	RuleBaseFacilityFunctions _requiresBaseFunc;
@@ -51,6 +86,7 @@ class RuleResearch
 	bool _sequentialGetOneFree;
 	std::map<std::string, std::vector<std::string> > _getOneFreeProtectedName;
 	std::map<const RuleResearch*, std::vector<const RuleResearch*> > _getOneFreeProtected;
+	RuleResearchReverseLinks _reverseLinks;
 	bool _needItem, _destroyItem;
 	int _listOrder;
 
@@ -75,6 +111,8 @@ public:
 	int getCost() const;
 	/// Gets the research name.
 	const std::string &getName() const;
+	/// Gets the interned ID of research name, usable as dense index.
+	StringId getId() const { return _id; }
 	/// Gets the research dependencies.
 	const std::vector<const RuleResearch*> &getDependencies() const;
 	/// Checks if this ResearchProject gives free topics in sequential order (or random order).
@@ -107,6 +145,10 @@ public:
 	const std::string & getSpawnedItem() const;
 	/// Gets the geoscape event to spawn when this topic is researched.
 	const std::string& getSpawnedEvent() const { return _spawnedEvent; }
+	/// Gets rules that refer to this research.
+	const RuleResearchReverseLinks& getReverseLinks() const { return _reverseLinks; }
+	/// Gets rules that refer to this research, to fill by Mod.
+	RuleResearchReverseLinks& getReverseLinks() { return _reverseLinks; }
 };
 
 }
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RulesetCache.h"
+#include <iterator>
+#include "../md5.h"
+#include "../Engine/CrossPlatform.h"
+#include "../Engine/Exception.h"
+#include "../Engine/Logger.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/**
+ * First bytes of cache file, need to be changed when format changes.
+ */
+const std::string CacheHeader = "OXCE ruleset cache 1\n";
+
+/**
+ * Types of nodes stored in cache.
+ */
+enum CacheNodeType : char
+{
+	CacheNull,
+	CacheScalar,
+	CacheSequence,
+	CacheMap,
+};
+
+void writeSize(std::string &out, size_t size)
+{
+	while (size >= 0x80)
+	{
+		out.push_back((char)((size & 0x7F) | 0x80));
+		size >>= 7;
+	}
+	out.push_back((char)size);
+}
+
+void writeString(std::string &out, const std::string &str)
+{
+	writeSize(out, str.size());
+	out.append(str);
+}
+
+void writeNode(std::string &out, const YAML::Node &node)
+{
+	switch (node.Type())
+	{
+	case YAML::NodeType::Scalar:
+		out.push_back(CacheScalar);
+		writeString(out, node.Tag());
+		writeString(out, node.Scalar());
+		break;
+	case YAML::NodeType::Sequence:
+		out.push_back(CacheSequence);
+		writeString(out, node.Tag());
+		writeSize(out, node.size());
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			writeNode(out, *i);
+		}
+		break;
+	case YAML::NodeType::Map:
+		out.push_back(CacheMap);
+		writeString(out, node.Tag());
+		writeSize(out, node.size());
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			writeNode(out, i->first);
+			writeNode(out, i->second);
+		}
+		break;
+	default:
+		out.push_back(CacheNull);
+		writeString(out, node.Tag());
+		break;
+	}
+}
+
+/**
+ * Checks if node or any of its children is tagged as `!info`, it prints line numbers while loading.
+ */
+bool hasInfoTag(const YAML::Node &node)
+{
+	if (node.Tag() == "!info")
+	{
+		return true;
+	}
+	if (node.IsSequence())
+	{
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			if (hasInfoTag(*i))
+			{
+				return true;
+			}
+		}
+	}
+	else if (node.IsMap())
+	{
+		for (YAML::const_iterator i = node.begin(); i != node.end(); ++i)
+		{
+			if (hasInfoTag(i->first) || hasInfoTag(i->second))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/**
+ * Helper reading data written by functions above.
+ * Throws on any malformed data.
+ */
+struct CacheReader
+{
+	const char *curr;
+	const char *end;
+
+	char readChar()
+	{
+		if (curr == end)
+		{
+			throw Exception("Unexpected end of ruleset cache");
+		}
+		return *curr++;
+	}
+
+	size_t readSize()
+	{
+		size_t size = 0;
+		for (int shift = 0; shift < 64; shift += 7)
+		{
+			unsigned char c = readChar();
+			size |= (size_t)(c & 0x7F) << shift;
+			if ((c & 0x80) == 0)
+			{
+				return size;
+			}
+		}
+		throw Exception("Invalid size in ruleset cache");
+	}
+
+	std::string readString()
+	{
+		size_t size = readSize();
+		if ((size_t)(end - curr) < size)
+		{
+			throw Exception("Unexpected end of ruleset cache");
+		}
+		std::string str(curr, size);
+		curr += size;
+		return str;
+	}
+
+	YAML::Node readNode()
+	{
+		char type = readChar();
+		std::string tag = readString();
+		YAML::Node node;
+		switch (type)
+		{
+		case CacheNull:
+			node = YAML::Node(YAML::NodeType::Null);
+			break;
+		case CacheScalar:
+			node = YAML::Node(readString());
+			break;
+		case CacheSequence:
+		{
+			node = YAML::Node(YAML::NodeType::Sequence);
+			for (size_t i = readSize(); i > 0; --i)
+			{
+				node.push_back(readNode());
+			}
+			break;
+		}
+		case CacheMap:
+		{
+			node = YAML::Node(YAML::NodeType::Map);
+			for (size_t i = readSize(); i > 0; --i)
+			{
+				YAML::Node key = readNode();
+				node.force_insert(key, readNode());
+			}
+			break;
+		}
+		default:
+			throw Exception("Invalid node in ruleset cache");
+		}
+		node.SetTag(tag);
+		return node;
+	}
+};
+
+}
+
+/**
+ * Creates a cache and loads all entries from given file.
+ * Missing or broken file gives empty cache.
+ * @param path Full path to cache file.
+ */
+RulesetCache::RulesetCache(const std::string &path) : _path(path), _changed(false)
+{
+	if (!CrossPlatform::fileExists(_path))
+	{
+		return;
+	}
+	try
+	{
+		auto file = CrossPlatform::readFile(_path);
+		std::string data((std::istreambuf_iterator<char>(*file)), std::istreambuf_iterator<char>());
+		if (data.compare(0, CacheHeader.size(), CacheHeader) != 0)
+		{
+			Log(LOG_INFO) << "Ruleset cache has old format, ignoring it.";
+			return;
+		}
+		CacheReader reader = { data.data() + CacheHeader.size(), data.data() + data.size() };
+		for (size_t i = reader.readSize(); i > 0; --i)
+		{
+			std::string key = reader.readString();
+			_entries[key] = reader.readString();
+		}
+	}
+	catch (Exception &e)
+	{
+		Log(LOG_WARNING) << "Ruleset cache is broken, ignoring it: " << e.what();
+		_entries.clear();
+	}
+}
+
+/**
+ * Gets key identifying ruleset file in cache.
+ * @param fileData Whole content of file.
+ * @return Hash of file content.
+ */
+std::string RulesetCache::getKey(const std::string &fileData)
+{
+	return MD5(fileData).hexdigest();
+}
+
+/**
+ * Converts parsed ruleset file to form stored in cache.
+ * Can be called from many threads at once.
+ * @param doc Parsed file.
+ * @return Binary data, empty if file can't be cached.
+ */
+std::string RulesetCache::serialize(const YAML::Node &doc)
+{
+	std::string out;
+	if (hasInfoTag(doc))
+	{
+		return out;
+	}
+	writeNode(out, doc);
+	return out;
+}
+
+/**
+ * Gets parsed ruleset file from cache.
+ * Can be called from many threads at once.
+ * @param key Key of file.
+ * @param doc Node where file will be stored.
+ * @return True if file was found in cache.
+ */
+bool RulesetCache::find(const std::string &key, YAML::Node &doc) const
+{
+	auto i = _entries.find(key);
+	if (i == _entries.end())
+	{
+		return false;
+	}
+	try
+	{
+		CacheReader reader = { i->second.data(), i->second.data() + i->second.size() };
+		doc = reader.readNode();
+		return true;
+	}
+	catch (Exception &)
+	{
+		return false;
+	}
+}
+
+/**
+ * Marks entry as used, only used entries are kept when saving cache.
+ * Entry stays available, other mods can have file with same content.
+ * @param key Key of file.
+ */
+void RulesetCache::use(const std::string &key)
+{
+	if (_entries.find(key) != _entries.end())
+	{
+		_used.insert(key);
+	}
+}
+
+/**
+ * Adds newly parsed file to cache.
+ * @param key Key of file.
+ * @param data Result of serialize(), empty data is not stored.
+ */
+void RulesetCache::add(const std::string &key, std::string &&data)
+{
+	if (data.empty())
+	{
+		return;
+	}
+	_entries[key] = std::move(data);
+	_used.insert(key);
+	_changed = true;
+}
+
+/**
+ * Writes all used entries to cache file, if anything changed from last time.
+ */
+void RulesetCache::save()
+{
+	if (!_changed && _used.size() == _entries.size())
+	{
+		return;
+	}
+	for (auto i = _entries.begin(); i != _entries.end();)
+	{
+		if (_used.find(i->first) == _used.end())
+		{
+			i = _entries.erase(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+	std::string out = CacheHeader;
+	writeSize(out, _entries.size());
+	for (const auto &i : _entries)
+	{
+		writeString(out, i.first);
+		writeString(out, i.second);
+	}
+	if (!CrossPlatform::writeFile(_path, out))
+	{
+		Log(LOG_WARNING) << "Failed to write ruleset cache: " << _path;
+	}
+	_changed = false;
+}
+
+/**
+ * Removes cache file, next load will parse all files again.
+ */
+void RulesetCache::discard()
+{
+	_entries.clear();
+	_used.clear();
+	_changed = false;
+	if (CrossPlatform::fileExists(_path))
+	{
+		CrossPlatform::deleteFile(_path);
+	}
+}
+
+}
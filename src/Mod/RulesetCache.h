@@ -0,0 +1,60 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <yaml-cpp/yaml.h>
+
+namespace OpenXcom
+{
+
+/**
+ * Cache of already parsed ruleset files, stored in compact binary form in user folder.
+ * Entries are keyed by hash of file content, any change to file makes it parsed again.
+ * Entries not used during one load are dropped when cache is saved.
+ * Cached nodes do not have line numbers, files using `!info` tag are never cached because of that.
+ */
+class RulesetCache
+{
+private:
+	std::string _path;
+	std::unordered_map<std::string, std::string> _entries;
+	std::unordered_set<std::string> _used;
+	bool _changed;
+public:
+	/// Creates a cache and reads it from given file.
+	RulesetCache(const std::string &path);
+	/// Gets key of ruleset file.
+	static std::string getKey(const std::string &fileData);
+	/// Converts parsed file to its cached form.
+	static std::string serialize(const YAML::Node &doc);
+	/// Gets parsed file from cache.
+	bool find(const std::string &key, YAML::Node &doc) const;
+	/// Marks entry as used in current load.
+	void use(const std::string &key);
+	/// Adds new entry to cache.
+	void add(const std::string &key, std::string &&data);
+	/// Writes cache to file if anything changed.
+	void save();
+	/// Removes cache file.
+	void discard();
+};
+
+}
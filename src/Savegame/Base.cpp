@@ -164,20 +164,8 @@ void Base::load(const YAML::Node &node, SavedGame *save, bool newGame, bool newB
 		}
 	}
 
-	_items->load(node["items"]);
-	// Some old saves have bad items, better get rid of them to avoid further bugs
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end();)
-	{
-		if (_mod->getItem(i->first) == 0)
-		{
-			Log(LOG_ERROR) << "Failed to load item " << i->first;
-			_items->getContents()->erase(i++);
-		}
-		else
-		{
-			++i;
-		}
-	}
+	// bad items from old saves are dropped by container
+	_items->load(node["items"], _mod);
 
 	_scientists = node["scientists"].as<int>(_scientists);
 	_engineers = node["engineers"].as<int>(_engineers);
@@ -678,9 +666,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 			}
 		}
 	}
-	for (const auto& storeItem : *_items->getContents())
+	for (const auto& storeItem : _items->getContents())
 	{
-		auto ruleItem = _mod->getItem(storeItem.first, true);
+		auto ruleItem = storeItem.first;
 		if (ruleItem->getMonthlySalary() != 0)
 		{
 			staffCount += storeItem.second;
@@ -694,9 +682,9 @@ int Base::getTotalOtherStaffAndInventoryCost(int& staffCount, int& inventoryCoun
 	}
 	for (auto craft : _crafts)
 	{
-		for (const auto &craftItem : *craft->getItems()->getContents())
+		for (const auto &craftItem : craft->getItems()->getContents())
 		{
-			auto ruleItem = _mod->getItem(craftItem.first, true);
+			auto ruleItem = craftItem.first;
 			if (ruleItem->getMonthlySalary() != 0)
 			{
 				staffCount += craftItem.second;
@@ -785,10 +773,10 @@ int Base::getAvailableQuarters() const
  */
 double Base::getUsedStores() const
 {
-	double total = _items->getTotalSize(_mod);
+	double total = _items->getTotalSize();
 	for (std::vector<Craft*>::const_iterator i = _crafts.begin(); i != _crafts.end(); ++i)
 	{
-		total += (*i)->getTotalItemStorageSize(_mod);
+		total += (*i)->getTotalItemStorageSize();
 	}
 	for (std::vector<Transfer*>::const_iterator i = _transfers.begin(); i != _transfers.end(); ++i)
 	{
@@ -799,7 +787,7 @@ double Base::getUsedStores() const
 		else if ((*i)->getType() == TRANSFER_CRAFT)
 		{
 			Craft *craft = (*i)->getCraft();
-			total += craft->getTotalItemStorageSize(_mod);
+			total += craft->getTotalItemStorageSize();
 		}
 	}
 	return total;
@@ -830,14 +818,14 @@ bool Base::storesOverfullCritical() const
 	double total = 0;
 	for (std::vector<Craft*>::const_iterator i = _crafts.begin(); i != _crafts.end(); ++i)
 	{
-		total += (*i)->getTotalItemStorageSize(_mod);
+		total += (*i)->getTotalItemStorageSize();
 	}
 	for (std::vector<Transfer*>::const_iterator i = _transfers.begin(); i != _transfers.end(); ++i)
 	{
 		if ((*i)->getType() == TRANSFER_CRAFT)
 		{
 			Craft *craft = (*i)->getCraft();
-			total += craft->getTotalItemStorageSize(_mod);
+			total += craft->getTotalItemStorageSize();
 		}
 	}
 	int used = total * 100;
@@ -1287,7 +1275,7 @@ void Base::removeResearch(ResearchProject * project)
 	{
 		if (ruleResearch->needItem() && ruleResearch->destroyItem())
 		{
-			getStorageItems()->addItem(ruleResearch->getName(), 1);
+			getStorageItems()->addItem(_mod->getItem(ruleResearch->getName()), 1);
 		}
 	}
 
@@ -1424,13 +1412,13 @@ int Base::getFreeTrainingSpace() const
 int Base::getUsedContainment(int prisonType) const
 {
 	int total = 0;
-	RuleItem *rule = 0;
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); ++i)
+	const RuleItem *rule = 0;
+	for (const auto &i : _items->getContents())
 	{
-		rule = _mod->getItem((i)->first, true);
+		rule = i.first;
 		if (rule->isAlien() && rule->getPrisonType() == prisonType)
 		{
-			total += (i)->second;
+			total += i.second;
 		}
 	}
 	for (std::vector<Transfer*>::const_iterator i = _transfers.begin(); i != _transfers.end(); ++i)
@@ -1577,12 +1565,11 @@ void Base::setupDefenses()
 	}
 
 	// add vehicles left on the base
-	for (std::map<std::string, int>::iterator i = _items->getContents()->begin(); i != _items->getContents()->end(); )
+	for (const auto &i : _items->getContents())
 	{
-		std::string itemId = (i)->first;
-		int itemQty = (i)->second;
-		RuleItem *rule = _mod->getItem(itemId, true);
-		if (rule->getVehicleUnit())
+		int itemQty = _items->getItem(i.first); // can be changed by ammo of previous vehicles
+		RuleItem *rule = _mod->getItem(i.first->getType(), true);
+		if (rule->getVehicleUnit() && itemQty > 0)
 		{
 			int size = rule->getVehicleUnit()->getArmor()->getTotalSize();
 			if (rule->getVehicleClipAmmo() == nullptr) // so this vehicle does not need ammo
@@ -1593,7 +1580,7 @@ void Base::setupDefenses()
 					_vehicles.push_back(vehicle);
 					_vehiclesFromBase.push_back(vehicle);
 				}
-				_items->removeItem(itemId, itemQty);
+				_items->removeItem(rule, itemQty);
 			}
 			else // so this vehicle needs ammo
 			{
@@ -1603,7 +1590,6 @@ void Base::setupDefenses()
 				int baseQty = _items->getItem(ammo) / ammoPerVehicle;
 				if (!baseQty)
 				{
-					++i;
 					continue;
 				}
 				int canBeAdded = std::min(itemQty, baseQty);
@@ -1614,12 +1600,9 @@ void Base::setupDefenses()
 					_vehiclesFromBase.push_back(vehicle);
 					_items->removeItem(ammo, ammoPerVehicle);
 				}
-				_items->removeItem(itemId, canBeAdded);
+				_items->removeItem(rule, canBeAdded);
 			}
-
-			i = _items->getContents()->begin(); // we have to start over because iterator is broken because of the removeItem
 		}
-		else ++i;
 	}
 }
 
@@ -1857,12 +1840,11 @@ void Base::destroyFacility(std::vector<BaseFacility*>::iterator facility)
 			}
 
 			// remove all items
-			while (!(*facility)->getCraftForDrawing()->getItems()->getContents()->empty())
+			for (const auto &i : (*facility)->getCraftForDrawing()->getItems()->getContents())
 			{
-				std::map<std::string, int>::iterator i = (*facility)->getCraftForDrawing()->getItems()->getContents()->begin();
-				_items->addItem(i->first, i->second);
-				(*facility)->getCraftForDrawing()->getItems()->removeItem(i->first, i->second);
+				_items->addItem(i.first, i.second);
 			}
+			(*facility)->getCraftForDrawing()->getItems()->clear();
 			Collections::deleteIf(_crafts, 1,
 				[&](Craft* c)
 				{
@@ -2027,8 +2009,7 @@ void Base::cleanupDefenses(bool reclaimItems)
 		for (auto v : _vehiclesFromBase)
 		{
 			RuleItem *rule = v->getRules();
-			std::string type = rule->getType();
-			_items->addItem(type);
+			_items->addItem(rule);
 			if (rule->getVehicleClipAmmo())
 			{
 				_items->addItem(rule->getVehicleClipAmmo(), rule->getVehicleClipsLoaded());
@@ -2065,6 +2065,40 @@ void BattleUnit::clearVisibleTiles()
 	_visibleTiles.clear();
 }
 
+/**
+ * Remembers the 2d area that the last full visibility calculation of this unit covered.
+ * The area stays valid only as long as the unit keeps its position and facing.
+ * @param min Minimum corner of the area (z ignored).
+ * @param max Maximum corner of the area (z ignored).
+ */
+void BattleUnit::setViewArea(Position min, Position max)
+{
+	_viewAreaMin = min;
+	_viewAreaMax = max;
+	_viewAreaPos = _pos;
+	_viewAreaDirection = _direction;
+	_viewAreaDirectionTurret = _directionTurret;
+}
+
+/**
+ * Checks if an event could change the visible units or tiles of this unit.
+ * When the unit moved or turned since the area was stored, any event is considered relevant.
+ * @param eventPos Centre of the event.
+ * @param eventRadius Radius of circle big enough to encompass the event.
+ * @return True if visibility of this unit needs to be updated.
+ */
+bool BattleUnit::isViewAreaAffected(Position eventPos, int eventRadius) const
+{
+	if (_viewAreaDirection == -1 || eventRadius <= 0 || _viewAreaPos != _pos || _viewAreaDirection != _direction || _viewAreaDirectionTurret != _directionTurret)
+	{
+		return true;
+	}
+	// distance from the event to the closest point of the area
+	int dx = std::max(0, std::max(_viewAreaMin.x - eventPos.x, eventPos.x - _viewAreaMax.x));
+	int dy = std::max(0, std::max(_viewAreaMin.y - eventPos.y, eventPos.y - _viewAreaMax.y));
+	return dx * dx + dy * dy <= eventRadius * eventRadius;
+}
+
 /**
  * Get accuracy of different types of psi attack.
  * @param actionType Psi attack type.
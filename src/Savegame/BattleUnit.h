@@ -100,6 +100,8 @@ private:
 	std::vector<BattleUnit *> _visibleUnits, _unitsSpottedThisTurn;
 	std::vector<Tile *> _visibleTiles;
 	std::unordered_set<Tile *> _visibleTilesLookup;
+	Position _viewAreaMin, _viewAreaMax, _viewAreaPos;
+	int _viewAreaDirection = -1, _viewAreaDirectionTurret = -1;
 	int _tu, _energy, _health, _morale, _stunlevel, _mana;
 	bool _kneeled, _floating, _dontReselect;
 	bool _haveNoFloorBelow = false;
@@ -350,6 +352,10 @@ public:
 	const std::vector<Tile*> *getVisibleTiles();
 	/// Clear visible tiles.
 	void clearVisibleTiles();
+	/// Remember the area covered by the last full visibility calculation.
+	void setViewArea(Position min, Position max);
+	/// Could an event at this position change what this unit sees?
+	bool isViewAreaAffected(Position eventPos, int eventRadius) const;
 	/// Calculate psi attack accuracy.
 	static int getPsiAccuracy(BattleActionAttack::ReadOnly attack);
 	/// Calculate firing accuracy.
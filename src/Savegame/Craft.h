@@ -142,12 +142,12 @@ public:
 	std::vector<Vehicle*> *getVehicles();
 
 	/// Gets the total storage size of all items in the craft. Including vehicles+ammo and craft weapons+ammo.
-	double getTotalItemStorageSize(const Mod* mod) const;
+	double getTotalItemStorageSize() const;
 	/// Gets the total number of items of a given type in the craft. Including vehicles+ammo and craft weapons+ammo.
 	int getTotalItemCount(const RuleItem* item) const;
 
 	/// Update the craft's stats.
-	void addCraftStats(const RuleCraftStats& s);
+	void addCraftStats(const RuleCraftStats& s, const Mod *mod);
 	/// Gets the craft's stats.
 	const RuleCraftStats& getCraftStats() const;
 	/// Gets the craft's max amount of fuel.
@@ -229,9 +229,9 @@ public:
 	/// Checks if there are only permitted soldier types onboard.
 	bool areOnlyPermittedSoldierTypesOnboard(const RuleStartingCondition* sc);
 	/// Checks if there are enough required items onboard.
-	bool areRequiredItemsOnboard(const std::map<std::string, int>& requiredItems);
+	bool areRequiredItemsOnboard(const std::map<std::string, int>& requiredItems, const Mod *mod);
 	/// Destroys given required items.
-	void destroyRequiredItems(const std::map<std::string, int>& requiredItems);
+	void destroyRequiredItems(const std::map<std::string, int>& requiredItems, const Mod *mod);
 	/// Checks if there are enough pilots onboard.
 	bool arePilotsOnboard();
 	/// Checks if a pilot is already on the list.
@@ -17,6 +17,7 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ItemContainer.h"
+#include "../Engine/Logger.h"
 #include "../Mod/Mod.h"
 #include "../Mod/RuleItem.h"
 
@@ -26,7 +27,7 @@ namespace OpenXcom
 /**
  * Initializes an item container with no contents.
  */
-ItemContainer::ItemContainer()
+ItemContainer::ItemContainer() : _totalQuantity(0), _totalSize(0.0), _totalSizeValid(true)
 {
 }
 
@@ -40,10 +41,26 @@ ItemContainer::~ItemContainer()
 /**
  * Loads the item container from a YAML file.
  * @param node YAML node.
+ * @param mod Mod for looking up item types.
  */
-void ItemContainer::load(const YAML::Node &node)
+void ItemContainer::load(const YAML::Node &node, const Mod *mod)
 {
-	_qty = node.as< std::map<std::string, int> >(_qty);
+	if (!node)
+	{
+		return;
+	}
+	clear();
+	for (const auto &i : node.as< std::map<std::string, int> >(std::map<std::string, int>()))
+	{
+		const RuleItem *rule = mod->getItem(i.first);
+		if (rule == nullptr)
+		{
+			// Some old saves have bad items, better get rid of them to avoid further bugs
+			Log(LOG_ERROR) << "Failed to load item " << i.first;
+			continue;
+		}
+		addItem(rule, i.second);
+	}
 }
 
 /**
@@ -52,154 +69,143 @@ void ItemContainer::load(const YAML::Node &node)
  */
 YAML::Node ItemContainer::save() const
 {
-	YAML::Node node;
-	node = _qty;
-	return node;
-}
-
-/**
- * Adds an item amount to the container.
- * @param id Item ID.
- * @param qty Item quantity.
- */
-void ItemContainer::addItem(const std::string &id, int qty)
-{
-	if (id.empty())
+	YAML::Node node(YAML::NodeType::Map);
+	for (const auto &i : getContents())
 	{
-		return;
+		node[i.first->getType()] = i.second;
 	}
-	_qty[id] += qty;
+	return node;
 }
 
 /**
  * Adds an item amount to the container.
- * @param id Item ID.
+ * @param item Item rule.
  * @param qty Item quantity.
  */
 void ItemContainer::addItem(const RuleItem* item, int qty)
 {
-	if (item)
-	{
-		addItem(item->getType(), qty);
-	}
-}
-
-/**
- * Removes an item amount from the container.
- * @param id Item ID.
- * @param qty Item quantity.
- */
-void ItemContainer::removeItem(const std::string &id, int qty)
-{
-	if (id.empty())
-	{
-		return;
-	}
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return;
-	}
-
-	if (qty < it->second)
-	{
-		it->second -= qty;
-	}
-	else
+	if (item && item->getIndex() >= 0)
 	{
-		_qty.erase(it);
+		size_t index = item->getIndex();
+		if (index >= _qty.size())
+		{
+			_qty.resize(index + 1);
+			_rules.resize(index + 1);
+		}
+		_rules[index] = item;
+		_qty[index] += qty;
+		_totalQuantity += qty;
+		_totalSizeValid = false;
 	}
 }
 
 /**
  * Removes an item amount from the container.
- * @param id Item ID.
+ * @param item Item rule.
  * @param qty Item quantity.
  */
 void ItemContainer::removeItem(const RuleItem* item, int qty)
 {
-	if (item)
+	if (item && item->getIndex() >= 0)
 	{
-		removeItem(item->getType(), qty);
+		size_t index = item->getIndex();
+		if (index >= _qty.size() || _qty[index] == 0)
+		{
+			return;
+		}
+
+		int removed = qty < _qty[index] ? qty : _qty[index];
+		_qty[index] -= removed;
+		_totalQuantity -= removed;
+		_totalSizeValid = false;
 	}
 }
 
 /**
  * Returns the quantity of an item in the container.
- * @param id Item ID.
+ * @param item Item rule.
  * @return Item quantity.
  */
-int ItemContainer::getItem(const std::string &id) const
+int ItemContainer::getItem(const RuleItem* item) const
 {
-	if (id.empty())
-	{
-		return 0;
-	}
-
-	auto it = _qty.find(id);
-	if (it == _qty.end())
-	{
-		return 0;
-	}
-	else
+	if (item && item->getIndex() >= 0)
 	{
-		return it->second;
+		size_t index = item->getIndex();
+		if (index < _qty.size())
+		{
+			return _qty[index];
+		}
 	}
+	return 0;
 }
 
 /**
- * Returns the quantity of an item in the container.
- * @param id Item ID.
- * @return Item quantity.
+ * Returns the total size of the items in the container.
+ * Sum is cached until container changes, it is done in order of
+ * item types, so it gives exactly same result every time.
+ * @return Total item size.
  */
-int ItemContainer::getItem(const RuleItem* item) const
+double ItemContainer::getTotalSize() const
 {
-	if (item)
-	{
-		return getItem(item->getType());
-	}
-	else
+	if (!_totalSizeValid)
 	{
-		return 0;
+		_totalSize = 0;
+		for (size_t i = 0; i < _qty.size(); ++i)
+		{
+			if (_qty[i] != 0)
+			{
+				_totalSize += _rules[i]->getSize() * _qty[i];
+			}
+		}
+		_totalSizeValid = true;
 	}
+	return _totalSize;
 }
 
 /**
- * Returns the total quantity of the items in the container.
- * @return Total item quantity.
+ * Checks if the container has no items.
+ * @return True if there is no item.
  */
-int ItemContainer::getTotalQuantity() const
+bool ItemContainer::empty() const
 {
-	int total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
+	for (int qty : _qty)
 	{
-		total += i->second;
+		if (qty != 0)
+		{
+			return false;
+		}
 	}
-	return total;
+	return true;
 }
 
 /**
- * Returns the total size of the items in the container.
- * @param mod Pointer to mod.
- * @return Total item size.
+ * Removes all items from the container.
  */
-double ItemContainer::getTotalSize(const Mod *mod) const
+void ItemContainer::clear()
 {
-	double total = 0;
-	for (std::map<std::string, int>::const_iterator i = _qty.begin(); i != _qty.end(); ++i)
-	{
-		total += mod->getItem(i->first, true)->getSize() * i->second;
-	}
-	return total;
+	_qty.clear();
+	_rules.clear();
+	_totalQuantity = 0;
+	_totalSize = 0.0;
+	_totalSizeValid = true;
 }
 
 /**
- * Returns all the items currently contained within.
+ * Returns all the items currently contained within,
+ * sorted by item type like in saves.
  * @return List of contents.
  */
-std::map<std::string, int> *ItemContainer::getContents()
+std::vector<std::pair<const RuleItem*, int>> ItemContainer::getContents() const
 {
-	return &_qty;
+	std::vector<std::pair<const RuleItem*, int>> contents;
+	for (size_t i = 0; i < _qty.size(); ++i)
+	{
+		if (_qty[i] != 0)
+		{
+			contents.push_back(std::make_pair(_rules[i], _qty[i]));
+		}
+	}
+	return contents;
 }
 
 }
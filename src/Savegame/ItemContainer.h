@@ -18,7 +18,8 @@
  * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include <string>
-#include <map>
+#include <vector>
+#include <utility>
 #include <yaml-cpp/yaml.h>
 
 namespace OpenXcom
@@ -31,38 +32,41 @@ class RuleItem;
  * Represents the items contained by a certain entity,
  * like base stores, craft equipment, etc.
  * Handles all necessary item management tasks.
+ * Quantities are stored in flat array indexed by RuleItem::getIndex().
  */
 class ItemContainer
 {
 private:
-	std::map<std::string, int> _qty;
+	std::vector<int> _qty;
+	std::vector<const RuleItem*> _rules;
+	int _totalQuantity;
+	mutable double _totalSize;
+	mutable bool _totalSizeValid;
 public:
 	/// Creates an empty item container.
 	ItemContainer();
 	/// Cleans up the item container.
 	~ItemContainer();
 	/// Loads the item container from YAML.
-	void load(const YAML::Node& node);
+	void load(const YAML::Node& node, const Mod *mod);
 	/// Saves the item container to YAML.
 	YAML::Node save() const;
 	/// Adds an item to the container.
-	void addItem(const std::string &id, int qty = 1);
-	/// Adds an item to the container.
 	void addItem(const RuleItem* item, int qty = 1);
 	/// Removes an item from the container.
-	void removeItem(const std::string &id, int qty = 1);
-	/// Removes an item from the container.
 	void removeItem(const RuleItem* item, int qty = 1);
 	/// Gets an item in the container.
-	int getItem(const std::string &id) const;
-	/// Gets an item in the container.
 	int getItem(const RuleItem* item) const;
 	/// Gets the total quantity of items in the container.
-	int getTotalQuantity() const;
+	int getTotalQuantity() const { return _totalQuantity; }
 	/// Gets the total size of items in the container.
-	double getTotalSize(const Mod *mod) const;
+	double getTotalSize() const;
+	/// Checks if the container has no items.
+	bool empty() const;
+	/// Removes all items from the container.
+	void clear();
 	/// Gets all the items in the container.
-	std::map<std::string, int> *getContents();
+	std::vector<std::pair<const RuleItem*, int>> getContents() const;
 };
 
 }
@@ -159,7 +159,7 @@ productionProgress_e Production::step(Base * b, SavedGame * g, const Mod *m, Lan
 						g->setFunds(g->getFunds() + (i.first->getSellCost() * i.second));
 					else
 					{
-						b->getStorageItems()->addItem(i.first->getType(), i.second);
+						b->getStorageItems()->addItem(i.first, i.second);
 						if (!_rules->getRandomProducedItems().empty())
 						{
 							_randomProductionInfo[i.first->getType()] += i.second;
@@ -192,7 +192,7 @@ productionProgress_e Production::step(Base * b, SavedGame * g, const Mod *m, Lan
 					{
 						for (auto& i : itemSet.second)
 						{
-							b->getStorageItems()->addItem(i.first->getType(), i.second);
+							b->getStorageItems()->addItem(i.first, i.second);
 							_randomProductionInfo[i.first->getType()] += i.second;
 							if (i.first->getBattleType() == BT_NONE)
 							{
@@ -304,7 +304,7 @@ void Production::refundItem(Base * b, SavedGame * g, const Mod *m) const
 	g->setFunds(g->getFunds() + _rules->getManufactureCost());
 	for (auto& iter : _rules->getRequiredItems())
 	{
-		b->getStorageItems()->addItem(iter.first->getType(), iter.second);
+		b->getStorageItems()->addItem(iter.first, iter.second);
 	}
 	//for (auto& it : _rules->getRequiredCrafts())
 	//{
@@ -750,7 +750,7 @@ void SaveConverter::loadDatBase()
 				int qty = load<Uint16>(bdata + _rules->getOffset("BASE.DAT_ITEMS") + k * 2);
 				if (qty != 0 && !_rules->getItems()[k].empty())
 				{
-					base->getStorageItems()->addItem(_rules->getItems()[k], qty);
+					base->getStorageItems()->addItem(_mod->getItem(_rules->getItems()[k]), qty);
 				}
 			}
 			base->setEngineers(engineers);
@@ -794,7 +794,7 @@ void SaveConverter::loadDatAStore()
 			if (base != 0xFF)
 			{
 				Base *b = dynamic_cast<Base*>(_targets[base]);
-				b->getStorageItems()->addItem(liveAlien);
+				b->getStorageItems()->addItem(_mod->getItem(liveAlien));
 			}
 		}
 		_aliens.push_back(liveAlien);
@@ -926,7 +926,7 @@ void SaveConverter::loadDatCraft()
 					int qty = load<Uint8>(cdata + _rules->getOffset("CRAFT.DAT_ITEMS") + k);
 					if (qty != 0 && !_rules->getItems()[k + 10].empty())
 					{
-						craft->getItems()->addItem(_rules->getItems()[k + 10], qty);
+						craft->getItems()->addItem(_mod->getItem(_rules->getItems()[k + 10]), qty);
 					}
 				}
 
@@ -154,7 +154,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 	_reinforcementsDeployment = node["reinforcementsDeployment"].as<std::string>(_reinforcementsDeployment);
 	_reinforcementsRace = node["reinforcementsRace"].as<std::string>(_reinforcementsRace);
 	_reinforcementsItemLevel = node["reinforcementsItemLevel"].as<int>(_reinforcementsItemLevel);
-	_reinforcementsMemory = node["reinforcementsMemory"].as< std::map<std::string, int> >(_reinforcementsMemory);
+	_reinforcementsMemory.fromMap(node["reinforcementsMemory"].as< std::map<std::string, int> >(_reinforcementsMemory.toMap()));
 	_reinforcementsBlocks = node["reinforcementsBlocks"].as< std::vector< std::vector<int> > >(_reinforcementsBlocks);
 	_flattenedMapTerrainNames = node["flattenedMapTerrainNames"].as< std::vector< std::vector<std::string> > >(_flattenedMapTerrainNames);
 	_flattenedMapBlockNames = node["flattenedMapBlockNames"].as< std::vector< std::vector<std::string> > >(_flattenedMapBlockNames);
@@ -404,7 +404,7 @@ void SavedBattleGame::load(const YAML::Node &node, Mod *mod, SavedGame* savedGam
 	_maxAmbienceRandomDelay = node["maxAmbienceRandomDelay"].as<int>(_maxAmbienceRandomDelay);
 	_currentAmbienceDelay = node["currentAmbienceDelay"].as<int>(_currentAmbienceDelay);
 	_music = node["music"].as<std::string>(_music);
-	_baseItems->load(node["baseItems"]);
+	_baseItems->load(node["baseItems"], mod);
 	_turnLimit = node["turnLimit"].as<int>(_turnLimit);
 	_chronoTrigger = ChronoTrigger(node["chronoTrigger"].as<int>(_chronoTrigger));
 	_cheatTurn = node["cheatTurn"].as<int>(_cheatTurn);
@@ -491,7 +491,7 @@ YAML::Node SavedBattleGame::save() const
 	node["reinforcementsDeployment"] = _reinforcementsDeployment;
 	node["reinforcementsRace"] = _reinforcementsRace;
 	node["reinforcementsItemLevel"] = _reinforcementsItemLevel;
-	node["reinforcementsMemory"] = _reinforcementsMemory;
+	node["reinforcementsMemory"] = _reinforcementsMemory.toMap();
 	node["reinforcementsBlocks"] = _reinforcementsBlocks;
 	node["flattenedMapTerrainNames"] = _flattenedMapTerrainNames;
 	node["flattenedMapBlockNames"] = _flattenedMapBlockNames;
@@ -614,9 +614,10 @@ void SavedBattleGame::initMap(int mapsize_x, int mapsize_y, int mapsize_z, bool
 
 	_tiles.clear();
 	_tiles.reserve(_mapsize_z * _mapsize_y * _mapsize_x);
+	_tileHotData.resize(_mapsize_z * _mapsize_y * _mapsize_x);
 	for (int i = 0; i < _mapsize_z * _mapsize_y * _mapsize_x; ++i)
 	{
-		_tiles.push_back(Tile(getTileCoords(i)));
+		_tiles.push_back(Tile(getTileCoords(i), &_tileHotData, i));
 	}
 
 }
@@ -1873,7 +1874,7 @@ void SavedBattleGame::prepareNewTurn()
 	// prepare a list of tiles on fire
 	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 	{
-		if (getTile(i)->getFire() > 0)
+		if (_tileHotData.fire[i] > 0)
 		{
 			tilesOnFire.push_back(getTile(i));
 		}
@@ -1914,6 +1915,7 @@ void SavedBattleGame::prepareNewTurn()
 				{
 					if ((*i)->getMapData(O_OBJECT)->getFlammable() != 255 && (*i)->getMapData(O_OBJECT)->getArmor() != 255)
 					{
+						getPathfinding()->invalidateTerrain((*i)->getPosition());
 						if ((*i)->destroy(O_OBJECT, getObjectiveType()))
 						{
 							addDestroyedObjective();
@@ -1928,6 +1930,7 @@ void SavedBattleGame::prepareNewTurn()
 				{
 					if ((*i)->getMapData(O_FLOOR)->getFlammable() != 255 && (*i)->getMapData(O_FLOOR)->getArmor() != 255)
 					{
+						getPathfinding()->invalidateTerrain((*i)->getPosition());
 						if ((*i)->destroy(O_FLOOR, getObjectiveType()))
 						{
 							addDestroyedObjective();
@@ -1942,7 +1945,7 @@ void SavedBattleGame::prepareNewTurn()
 	// prepare a list of tiles on fire/with smoke in them (smoke acts as fire intensity)
 	for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 	{
-		if (getTile(i)->getSmoke() > 0)
+		if (_tileHotData.smoke[i] > 0)
 		{
 			tilesOnSmoke.push_back(getTile(i));
 		}
@@ -2006,7 +2009,7 @@ void SavedBattleGame::prepareNewTurn()
 		// do damage to units, average out the smoke, etc.
 		for (int i = 0; i < _mapsize_x * _mapsize_y * _mapsize_z; ++i)
 		{
-			if (getTile(i)->getSmoke() != 0)
+			if (_tileHotData.smoke[i] != 0)
 				getTile(i)->prepareNewTurn(getDepth() == 0);
 		}
 	}
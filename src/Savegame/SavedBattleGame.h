@@ -22,6 +22,7 @@
 #include <yaml-cpp/yaml.h>
 #include "Tile.h"
 #include "../Mod/AlienDeployment.h"
+#include "../Engine/StringId.h"
 
 namespace OpenXcom
 {
@@ -64,6 +65,7 @@ private:
 	int _mapsize_x, _mapsize_y, _mapsize_z;
 	std::vector<MapDataSet*> _mapDataSets;
 	std::vector<Tile> _tiles;
+	TileHotData _tileHotData;
 	BattleUnit *_selectedUnit, *_lastSelectedUnit;
 	std::vector<Node*> _nodes;
 	std::vector<BattleUnit*> _units;
@@ -73,7 +75,7 @@ private:
 	std::string _missionType, _strTarget, _strCraftOrBase, _alienCustomDeploy, _alienCustomMission;
 	std::string _reinforcementsDeployment, _reinforcementsRace;
 	int _reinforcementsItemLevel;
-	std::map<std::string, int> _reinforcementsMemory;
+	StringIdArray<int> _reinforcementsMemory;
 	std::vector< std::vector<int> > _reinforcementsBlocks;
 	std::vector< std::vector<std::string> > _flattenedMapTerrainNames;
 	std::vector< std::vector<std::string> > _flattenedMapBlockNames;
@@ -172,7 +174,7 @@ public:
 	/// Gets the alien item level to use for reinforcements.
 	int getReinforcementsItemLevel() const { return _reinforcementsItemLevel; }
 	/// Gets the memory used for reinforcements.
-	std::map<std::string, int> &getReinforcementsMemory() { return _reinforcementsMemory; }
+	StringIdArray<int> &getReinforcementsMemory() { return _reinforcementsMemory; }
 	/// Gets the map blocks used for reinforcements.
 	std::vector< std::vector<int> > &getReinforcementsBlocks() { return _reinforcementsBlocks; }
 
@@ -256,6 +258,15 @@ public:
 		return &_tiles[i];
 	}
 
+	/**
+	 * Gets often used data of all tiles, stored in separate arrays indexed by tile index.
+	 * @return Tile data.
+	 */
+	TileHotData &getTileHotData()
+	{
+		return _tileHotData;
+	}
+
 	/**
 	 * Get tile that is below current one (const version).
 	 * @param tile
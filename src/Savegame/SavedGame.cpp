@@ -131,11 +131,6 @@ bool haveReserchVector(const std::vector<const RuleResearch*> &vec, const RuleRe
 	return find != vec.end() && *find == res;
 }
 
-bool haveReserchVector(const std::vector<const RuleResearch*> &vec,  const std::string &res)
-{
-	auto find = std::find_if(vec.begin(), vec.end(), [&](const RuleResearch* r){ return r->getName() == res; });
-	return find != vec.end();
-}
 
 }
 
@@ -578,19 +573,18 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		std::string research = it->as<std::string>();
 		if (mod->getResearch(research))
 		{
-			_discovered.push_back(mod->getResearch(research));
+			addDiscovered(mod->getResearch(research));
 		}
 		else
 		{
 			Log(LOG_ERROR) << "Failed to load research " << research;
 		}
 	}
-	sortReserchVector(_discovered);
 
-	_generatedEvents = doc["generatedEvents"].as< std::map<std::string, int> >(_generatedEvents);
-	_ufopediaRuleStatus = doc["ufopediaRuleStatus"].as< std::map<std::string, int> >(_ufopediaRuleStatus);
-	_manufactureRuleStatus = doc["manufactureRuleStatus"].as< std::map<std::string, int> >(_manufactureRuleStatus);
-	_researchRuleStatus = doc["researchRuleStatus"].as< std::map<std::string, int> >(_researchRuleStatus);
+	_generatedEvents.fromMap(doc["generatedEvents"].as< std::map<std::string, int> >(_generatedEvents.toMap()));
+	_ufopediaRuleStatus.fromMap(doc["ufopediaRuleStatus"].as< std::map<std::string, int> >(_ufopediaRuleStatus.toMap()));
+	_manufactureRuleStatus.fromMap(doc["manufactureRuleStatus"].as< std::map<std::string, int> >(_manufactureRuleStatus.toMap()));
+	_researchRuleStatus.fromMap(doc["researchRuleStatus"].as< std::map<std::string, int> >(_researchRuleStatus.toMap()));
 	_hiddenPurchaseItemsMap = doc["hiddenPurchaseItems"].as< std::map<std::string, bool> >(_hiddenPurchaseItemsMap);
 
 	for (YAML::const_iterator i = doc["bases"].begin(); i != doc["bases"].end(); ++i)
@@ -743,7 +737,7 @@ void SavedGame::load(const std::string &filename, Mod *mod, Language *lang)
 		std::string key = oss.str();
 		if (const YAML::Node &loadout = doc[key])
 		{
-			_globalCraftLoadout[j]->load(loadout);
+			_globalCraftLoadout[j]->load(loadout, mod);
 		}
 		std::ostringstream oss2;
 		oss2 << "globalCraftLoadoutName" << j;
@@ -885,10 +879,10 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 	{
 		node["poppedResearch"].push_back((*i)->getName());
 	}
-	node["generatedEvents"] = _generatedEvents;
-	node["ufopediaRuleStatus"] = _ufopediaRuleStatus;
-	node["manufactureRuleStatus"] = _manufactureRuleStatus;
-	node["researchRuleStatus"] = _researchRuleStatus;
+	node["generatedEvents"] = _generatedEvents.toMap();
+	node["ufopediaRuleStatus"] = _ufopediaRuleStatus.toMap();
+	node["manufactureRuleStatus"] = _manufactureRuleStatus.toMap();
+	node["researchRuleStatus"] = _researchRuleStatus.toMap();
 	node["hiddenPurchaseItems"] = _hiddenPurchaseItemsMap;
 	node["alienStrategy"] = _alienStrategy->save();
 	for (std::vector<Soldier*>::const_iterator i = _deadSoldiers.begin(); i != _deadSoldiers.end(); ++i)
@@ -925,7 +919,7 @@ void SavedGame::save(const std::string &filename, Mod *mod) const
 		std::ostringstream oss;
 		oss << "globalCraftLoadout" << j;
 		std::string key = oss.str();
-		if (!_globalCraftLoadout[j]->getContents()->empty())
+		if (!_globalCraftLoadout[j]->empty())
 		{
 			node[key] = _globalCraftLoadout[j]->save();
 		}
@@ -1477,6 +1471,38 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
 	if (r != _discovered.end())
 	{
 		_discovered.erase(r);
+		_discoveredSet[research->getId().getIndex()] = haveReserchVector(_discovered, research);
+		for (auto& unlocked : research->getUnlocked())
+		{
+			_unlockedCount[unlocked->getId().getIndex()] -= 1;
+		}
+	}
+}
+
+/**
+ * Adds research to list of discovered research, list is kept sorted.
+ * Set indexed by research ID is updated too, it is used for fast checks,
+ * same for counters of topics unlocked by discovered research.
+ * @param research Discovered research.
+ */
+void SavedGame::addDiscovered(const RuleResearch *research)
+{
+	_discovered.insert(std::upper_bound(_discovered.begin(), _discovered.end(), research, researchLess), research);
+	size_t tableSize = StringId::getTableSize();
+	size_t index = research->getId().getIndex();
+	if (index >= _discoveredSet.size())
+	{
+		_discoveredSet.resize(std::max(index + 1, tableSize));
+	}
+	_discoveredSet[index] = true;
+	for (auto& unlocked : research->getUnlocked())
+	{
+		size_t unlockedIndex = unlocked->getId().getIndex();
+		if (unlockedIndex >= _unlockedCount.size())
+		{
+			_unlockedCount.resize(std::max(unlockedIndex + 1, tableSize));
+		}
+		_unlockedCount[unlockedIndex] += 1;
 	}
 }
 
@@ -1486,8 +1512,7 @@ void SavedGame::removeDiscoveredResearch(const RuleResearch * research)
  */
 void SavedGame::addFinishedResearchSimple(const RuleResearch * research)
 {
-	_discovered.push_back(research);
-	sortReserchVector(_discovered);
+	addDiscovered(research);
 }
 
 /**
@@ -1522,8 +1547,7 @@ void SavedGame::addFinishedResearch(const RuleResearch * research, const Mod * m
 		bool checkRelatedZeroCostTopics = true;
 		if (!isResearched(currentQueueItem, false))
 		{
-			_discovered.push_back(currentQueueItem);
-			sortReserchVector(_discovered);
+			addDiscovered(currentQueueItem);
 			if (!hasUndiscoveredProtectedUnlocks && !hasAnyUndiscoveredGetOneFrees)
 			{
 				// If the currentQueueItem can't tell you anything anymore, remove it from popped research
@@ -1636,18 +1660,6 @@ const std::vector<const RuleResearch *> & SavedGame::getDiscoveredResearch() con
  */
 void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projects, const Mod *mod, Base *base, bool considerDebugMode) const
 {
-	// This list is used for topics that can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
-	// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
-	std::vector<const RuleResearch *> unlocked;
-	for (const RuleResearch *research : _discovered)
-	{
-		for (auto& itUnlocked : research->getUnlocked())
-		{
-			unlocked.push_back(itUnlocked);
-		}
-		sortReserchVector(unlocked);
-	}
-
 	// Create a list of research topics available for research in the given base
 	for (auto& pair : mod->getResearchMap())
 	{
@@ -1659,7 +1671,9 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 
 		RuleResearch *research = pair.second;
 
-		if ((considerDebugMode && _debug) || haveReserchVector(unlocked, research))
+		// Unlocked topics can be researched even if *not all* dependencies have been discovered yet (e.g. STR_ALIEN_ORIGINS)
+		// Note: all requirements of such topics *have to* be discovered though! This will be handled elsewhere.
+		if ((considerDebugMode && _debug) || isUnlocked(research->getId()))
 		{
 			// Empty, these research topics are on the "unlocked list", *don't* check the dependencies!
 		}
@@ -1711,7 +1725,7 @@ void SavedGame::getAvailableResearchProjects(std::vector<RuleResearch *> &projec
 			}
 
 			// Check for needed item in the given base
-			if (research->needItem() && base->getStorageItems()->getItem(research->getName()) == 0)
+			if (research->needItem() && base->getStorageItems()->getItem(mod->getItem(research->getName())) == 0)
 			{
 				continue;
 			}
@@ -1806,22 +1820,15 @@ void SavedGame::getAvailableProductions (std::vector<RuleManufacture *> & produc
  * @param mod the Game Mod
  * @param base a pointer to a Base
  */
-void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod * mod, Base *) const
+void SavedGame::getDependableManufacture (std::vector<RuleManufacture *> & dependables, const RuleResearch *research, const Mod *, Base *) const
 {
-	const std::vector<std::string> &mans = mod->getManufactureList();
-	for (std::vector<std::string>::const_iterator iter = mans.begin(); iter != mans.end(); ++iter)
+	for (RuleManufacture *m : research->getReverseLinks().requiredByManufacture)
 	{
 		// don't show previously unlocked (and seen!) manufacturing topics
-		std::map<std::string, int>::const_iterator i = _manufactureRuleStatus.find(*iter);
-		if (i != _manufactureRuleStatus.end())
-		{
-			if (i->second != RuleManufacture::MANU_STATUS_NEW)
-				continue;
-		}
+		if (_manufactureRuleStatus.get(m->getName()) != RuleManufacture::MANU_STATUS_NEW)
+			continue;
 
-		RuleManufacture *m = mod->getManufacture(*iter);
-		const auto &reqs = m->getRequirements();
-		if (isResearched(reqs) && std::find(reqs.begin(), reqs.end(), research) != reqs.end())
+		if (isResearched(m->getRequirements()))
 		{
 			dependables.push_back(m);
 		}
@@ -1861,24 +1868,15 @@ void SavedGame::getAvailableTransformations (std::vector<RuleSoldierTransformati
  * @param research The RuleResearch which has just been discovered
  * @param mod the Game Mod
  */
-void SavedGame::getDependablePurchase(std::vector<RuleItem *> & dependables, const RuleResearch *research, const Mod * mod) const
+void SavedGame::getDependablePurchase(std::vector<RuleItem *> & dependables, const RuleResearch *research, const Mod *) const
 {
-	const std::vector<std::string> &itemlist = mod->getItemsList();
-	for (std::vector<std::string>::const_iterator iter = itemlist.begin(); iter != itemlist.end(); ++iter)
+	for (RuleItem *item : research->getReverseLinks().requiredByItems)
 	{
-		RuleItem *item = mod->getItem(*iter);
 		if (item->getBuyCost() != 0)
 		{
-			const std::vector<const RuleResearch *> &reqs = item->getRequirements();
-			bool found = std::find(reqs.begin(), reqs.end(), research) != reqs.end();
-			const std::vector<const RuleResearch *> &reqsBuy = item->getBuyRequirements();
-			bool foundBuy = std::find(reqsBuy.begin(), reqsBuy.end(), research) != reqsBuy.end();
-			if (found || foundBuy)
+			if (isResearched(item->getBuyRequirements()) && isResearched(item->getRequirements()))
 			{
-				if (isResearched(item->getBuyRequirements()) && isResearched(item->getRequirements()))
-				{
-					dependables.push_back(item);
-				}
+				dependables.push_back(item);
 			}
 		}
 	}
@@ -1890,21 +1888,15 @@ void SavedGame::getDependablePurchase(std::vector<RuleItem *> & dependables, con
  * @param research The RuleResearch which has just been discovered
  * @param mod the Game Mod
  */
-void SavedGame::getDependableCraft(std::vector<RuleCraft *> & dependables, const RuleResearch *research, const Mod * mod) const
+void SavedGame::getDependableCraft(std::vector<RuleCraft *> & dependables, const RuleResearch *research, const Mod *) const
 {
-	const std::vector<std::string> &craftlist = mod->getCraftsList();
-	for (std::vector<std::string>::const_iterator iter = craftlist.begin(); iter != craftlist.end(); ++iter)
+	for (RuleCraft *craftItem : research->getReverseLinks().requiredByCrafts)
 	{
-		RuleCraft *craftItem = mod->getCraft(*iter);
 		if (craftItem->getBuyCost() != 0)
 		{
-			const std::vector<std::string> &reqs = craftItem->getRequirements();
-			if (std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+			if (isResearched(craftItem->getRequirements()))
 			{
-				if (isResearched(craftItem->getRequirements()))
-				{
-					dependables.push_back(craftItem);
-				}
+				dependables.push_back(craftItem);
 			}
 		}
 	}
@@ -1916,19 +1908,13 @@ void SavedGame::getDependableCraft(std::vector<RuleCraft *> & dependables, const
  * @param research The RuleResearch which has just been discovered
  * @param mod the Game Mod
  */
-void SavedGame::getDependableFacilities(std::vector<RuleBaseFacility *> & dependables, const RuleResearch *research, const Mod * mod) const
+void SavedGame::getDependableFacilities(std::vector<RuleBaseFacility *> & dependables, const RuleResearch *research, const Mod *) const
 {
-	const std::vector<std::string> &facilitylist = mod->getBaseFacilitiesList();
-	for (std::vector<std::string>::const_iterator iter = facilitylist.begin(); iter != facilitylist.end(); ++iter)
+	for (RuleBaseFacility *facilityItem : research->getReverseLinks().requiredByFacilities)
 	{
-		RuleBaseFacility *facilityItem = mod->getBaseFacility(*iter);
-		const std::vector<std::string> &reqs = facilityItem->getRequirements();
-		if (std::find(reqs.begin(), reqs.end(), research->getName()) != reqs.end())
+		if (isResearched(facilityItem->getRequirements()))
 		{
-			if (isResearched(facilityItem->getRequirements()))
-			{
-				dependables.push_back(facilityItem);
-			}
+			dependables.push_back(facilityItem);
 		}
 	}
 }
@@ -1938,9 +1924,9 @@ void SavedGame::getDependableFacilities(std::vector<RuleBaseFacility *> & depend
  * @param ufopediaRule Ufopedia rule ID.
  * @return Status (0=new, 1=normal).
  */
-int SavedGame::getUfopediaRuleStatus(const std::string &ufopediaRule)
+int SavedGame::getUfopediaRuleStatus(const std::string &ufopediaRule) const
 {
-	return _ufopediaRuleStatus[ufopediaRule];
+	return _ufopediaRuleStatus.get(ufopediaRule);
 }
 
 /**
@@ -1948,9 +1934,9 @@ int SavedGame::getUfopediaRuleStatus(const std::string &ufopediaRule)
  * @param manufactureRule Manufacture rule ID.
  * @return Status (0=new, 1=normal, 2=hidden).
  */
-int SavedGame::getManufactureRuleStatus(const std::string &manufactureRule)
+int SavedGame::getManufactureRuleStatus(const std::string &manufactureRule) const
 {
-	return _manufactureRuleStatus[manufactureRule];
+	return _manufactureRuleStatus.get(manufactureRule);
 }
 
 /**
@@ -1960,15 +1946,7 @@ int SavedGame::getManufactureRuleStatus(const std::string &manufactureRule)
  */
 bool SavedGame::isResearchRuleStatusNew(const std::string &researchRule) const
 {
-	auto it = _researchRuleStatus.find(researchRule);
-	if (it != _researchRuleStatus.end())
-	{
-		if (it->second != RuleResearch::RESEARCH_STATUS_NEW)
-		{
-			return false;
-		}
-	}
-	return true; // no status = new
+	return _researchRuleStatus.get(researchRule) == RuleResearch::RESEARCH_STATUS_NEW; // no status = new
 }
 
 /**
@@ -1978,15 +1956,7 @@ bool SavedGame::isResearchRuleStatusNew(const std::string &researchRule) const
  */
 bool SavedGame::isResearchRuleStatusDisabled(const std::string &researchRule) const
 {
-	auto it = _researchRuleStatus.find(researchRule);
-	if (it != _researchRuleStatus.end())
-	{
-		if (it->second == RuleResearch::RESEARCH_STATUS_DISABLED)
-		{
-			return true;
-		}
-	}
-	return false;
+	return _researchRuleStatus.get(researchRule) == RuleResearch::RESEARCH_STATUS_DISABLED;
 }
 
 /**
@@ -2062,7 +2032,7 @@ bool SavedGame::isResearched(const std::string &research, bool considerDebugMode
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return isDiscovered(StringId::find(research));
 }
 
 bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMode) const
@@ -2072,7 +2042,7 @@ bool SavedGame::isResearched(const RuleResearch *research, bool considerDebugMod
 	if (considerDebugMode && _debug)
 		return true;
 
-	return haveReserchVector(_discovered, research);
+	return isDiscovered(research->getId());
 }
 
 bool SavedGame::isResearched(const std::vector<std::string> &research, bool considerDebugMode) const
@@ -2084,7 +2054,7 @@ bool SavedGame::isResearched(const std::vector<std::string> &research, bool cons
 
 	for (const std::string &r : research)
 	{
-		if (!haveReserchVector(_discovered, r))
+		if (!isDiscovered(StringId::find(r)))
 		{
 			return false;
 		}
@@ -2106,29 +2076,18 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
 		return true;
 	if (considerDebugMode && _debug)
 		return true;
-	std::vector<const RuleResearch *> matches = research;
-	if (skipDisabled)
+	for (auto& r : research)
 	{
-		// ignore all disabled topics (as if they didn't exist)
-		for (std::vector<const RuleResearch *>::iterator j = matches.begin(); j != matches.end();)
+		if (isDiscovered(r->getId()))
 		{
-			if (isResearchRuleStatusDisabled((*j)->getName()))
-			{
-				j = matches.erase(j);
-			}
-			else
-			{
-				++j;
-			}
+			continue;
 		}
-	}
-
-	for (auto& r : matches)
-	{
-		if (!haveReserchVector(_discovered, r))
+		// ignore all disabled topics (as if they didn't exist)
+		if (skipDisabled && isResearchRuleStatusDisabled(r->getName()))
 		{
-			return false;
+			continue;
 		}
+		return false;
 	}
 
 	return true;
@@ -2138,13 +2097,15 @@ bool SavedGame::isResearched(const std::vector<const RuleResearch *> &research,
  * Returns if a certain item has been obtained, i.e. is present directly in the base stores.
  * Items in and on craft, in transfer, worn by soldiers, etc. are ignored!!
  * @param itemType Item ID.
+ * @param mod Mod for looking up item type.
  * @return Whether it's obtained or not.
  */
-bool SavedGame::isItemObtained(const std::string &itemType) const
+bool SavedGame::isItemObtained(const std::string &itemType, const Mod *mod) const
 {
+	const RuleItem *item = mod->getItem(itemType);
 	for (auto base : _bases)
 	{
-		if (base->getStorageItems()->getItem(itemType) > 0)
+		if (base->getStorageItems()->getItem(item) > 0)
 			return true;
 	}
 	return false;
@@ -2706,9 +2667,9 @@ void SavedGame::addGeneratedEvent(const RuleEvent* event)
  * @param eventName is the event we are checking for
  * @return whether or not it has been generated previously
  */
-bool SavedGame::wasEventGenerated(const std::string& eventName)
+bool SavedGame::wasEventGenerated(const std::string& eventName) const
 {
-	return (_generatedEvents.find(eventName) != _generatedEvents.end());
+	return _generatedEvents.get(eventName) != 0;
 }
 
 /**
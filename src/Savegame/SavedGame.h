@@ -30,6 +30,7 @@
 #include "../Mod/RuleManufacture.h"
 #include "../Mod/RuleBaseFacility.h"
 #include "../Engine/Script.h"
+#include "../Engine/StringId.h"
 
 namespace OpenXcom
 {
@@ -146,10 +147,12 @@ private:
 	AlienStrategy *_alienStrategy;
 	SavedBattleGame *_battleGame;
 	std::vector<const RuleResearch*> _discovered;
-	std::map<std::string, int> _generatedEvents;
-	std::map<std::string, int> _ufopediaRuleStatus;
-	std::map<std::string, int> _manufactureRuleStatus;
-	std::map<std::string, int> _researchRuleStatus;
+	std::vector<bool> _discoveredSet; // indexed by RuleResearch::getId()
+	std::vector<int> _unlockedCount; // indexed by RuleResearch::getId(), number of discovered topics that unlock it
+	StringIdArray<int> _generatedEvents;
+	StringIdArray<int> _ufopediaRuleStatus;
+	StringIdArray<int> _manufactureRuleStatus;
+	StringIdArray<int> _researchRuleStatus;
 	std::map<std::string, bool> _hiddenPurchaseItemsMap;
 	std::vector<AlienMission*> _activeMissions;
 	std::vector<GeoscapeEvent*> _geoscapeEvents;
@@ -175,6 +178,12 @@ private:
 	ScriptValues<SavedGame> _scriptValues;
 
 	static SaveInfo getSaveInfo(const std::string &file, Language *lang);
+	/// Adds research to sorted list and set of discovered research.
+	void addDiscovered(const RuleResearch *research);
+	/// Checks if any discovered research unlocks given topic.
+	bool isUnlocked(StringId id) const { return (size_t)id.getIndex() < _unlockedCount.size() && _unlockedCount[id.getIndex()] > 0; }
+	/// Checks discovered research set.
+	bool isDiscovered(StringId id) const { return id.isValid() && (size_t)id.getIndex() < _discoveredSet.size() && _discoveredSet[id.getIndex()]; }
 public:
 	static const std::string AUTOSAVE_GEOSCAPE, AUTOSAVE_BATTLESCAPE, QUICKSAVE;
 	/// Creates a new saved game.
@@ -296,13 +305,13 @@ public:
 	/// Get the list of newly available facilities to build once a research has been completed.
 	void getDependableFacilities(std::vector<RuleBaseFacility*> & dependables, const RuleResearch *research, const Mod *mod) const;
 	/// Gets the status of a ufopedia rule.
-	int getUfopediaRuleStatus(const std::string &ufopediaRule);
+	int getUfopediaRuleStatus(const std::string &ufopediaRule) const;
 	/// Gets the list of hidden items
 	const std::map<std::string, bool> &getHiddenPurchaseItems();
 	/// Gets the status of a manufacture rule.
-	int getManufactureRuleStatus(const std::string &manufactureRule);
+	int getManufactureRuleStatus(const std::string &manufactureRule) const;
 	/// Gets all the research rule status info.
-	const std::map<std::string, int> &getResearchRuleStatusRaw() const { return _researchRuleStatus; }
+	const StringIdArray<int> &getResearchRuleStatusRaw() const { return _researchRuleStatus; }
 	/// Is the research new?
 	bool isResearchRuleStatusNew(const std::string &researchRule) const;
 	/// Is the research permanently disabled?
@@ -320,7 +329,7 @@ public:
 	/// Gets if a certain list of research topics has been completed.
 	bool isResearched(const std::vector<const RuleResearch *> &research, bool considerDebugMode = true, bool skipDisabled = false) const;
 	/// Gets if a certain item has been obtained.
-	bool isItemObtained(const std::string &itemType) const;
+	bool isItemObtained(const std::string &itemType, const Mod *mod) const;
 	/// Gets if a certain facility has been built.
 	bool isFacilityBuilt(const std::string &facilityType) const;
 	/// Gets the soldier matching this ID.
@@ -396,7 +405,7 @@ public:
 	/// remembers that this event has been generated
 	void addGeneratedEvent(const RuleEvent* event);
 	/// checks if an event has been generated previously
-	bool wasEventGenerated(const std::string& eventName);
+	bool wasEventGenerated(const std::string& eventName) const;
 	/// Gets the list of dead soldiers.
 	std::vector<Soldier*> *getDeadSoldiers();
 	/// Gets the last selected player base.
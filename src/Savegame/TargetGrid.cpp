@@ -0,0 +1,159 @@
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TargetGrid.h"
+#include <algorithm>
+#include <cmath>
+#include "Target.h"
+#include "../fmath.h"
+
+namespace OpenXcom
+{
+
+namespace
+{
+
+/// Extra range added to queries, covers rounding errors of distance functions.
+const double QueryMargin = 1e-6;
+
+}
+
+/**
+ * Creates empty grid.
+ * @param cellSize Size of cell in radians, best close to typical query range.
+ */
+TargetGrid::TargetGrid(double cellSize) : _cellSize(cellSize), _rows(0), _cols(0), _count(0)
+{
+	_rows = std::max(1, (int)std::ceil(M_PI / _cellSize));
+	_cols = std::max(1, (int)std::ceil(2 * M_PI / _cellSize));
+	_cells.resize((size_t)_rows * _cols);
+}
+
+/**
+ * Gets row of latitude, values outside of globe are clamped.
+ * @param lat Latitude in radians.
+ * @return Row index.
+ */
+int TargetGrid::getRow(double lat) const
+{
+	int row = (int)std::floor((lat + M_PI_2) / _cellSize);
+	return Clamp(row, 0, _rows - 1);
+}
+
+/**
+ * Gets column of longitude, longitude is wrapped around globe.
+ * @param lon Longitude in radians.
+ * @return Column index.
+ */
+int TargetGrid::getCol(double lon) const
+{
+	int col = (int)std::floor(lon / _cellSize) % _cols;
+	if (col < 0)
+	{
+		col += _cols;
+	}
+	return col;
+}
+
+/**
+ * Removes all targets, keeps memory of cells for next use.
+ */
+void TargetGrid::clear()
+{
+	for (auto &cell : _cells)
+	{
+		cell.clear();
+	}
+	_count = 0;
+}
+
+/**
+ * Adds target to cell of its current position.
+ * @param target Target to add.
+ */
+void TargetGrid::insert(Target *target)
+{
+	_cells[getCell(getRow(target->getLatitude()), getCol(target->getLongitude()))].push_back(Entry{ target, _count });
+	++_count;
+}
+
+/**
+ * Gets all targets in cells that overlap circle around given point.
+ * Result can contain targets out of range but never skip one in range.
+ * Targets are in same order as they were added, so callers that
+ * stop on first match give same result as loop over all targets.
+ * @param lon Longitude of center in radians.
+ * @param lat Latitude of center in radians.
+ * @param range Great circle distance in radians.
+ * @param result Vector that get targets, old content is removed.
+ */
+void TargetGrid::query(double lon, double lat, double range, std::vector<Target*> &result) const
+{
+	result.clear();
+	if (_count == 0 || range < 0)
+	{
+		return;
+	}
+	range += QueryMargin;
+
+	int rowMin = getRow(lat - range);
+	int rowMax = getRow(lat + range);
+	int colMin = 0;
+	int colCount = _cols;
+	// near poles circle cover every longitude
+	if (lat - range > -M_PI_2 && lat + range < M_PI_2)
+	{
+		double halfWidth = std::asin(std::min(1.0, std::sin(range) / std::cos(lat)));
+		int first = (int)std::floor((lon - halfWidth) / _cellSize);
+		int last = (int)std::floor((lon + halfWidth) / _cellSize);
+		if (last - first + 1 < _cols)
+		{
+			colMin = (first % _cols + _cols) % _cols;
+			colCount = last - first + 1;
+		}
+	}
+
+	std::vector<Entry> found;
+	for (int row = rowMin; row <= rowMax; ++row)
+	{
+		for (int i = 0; i < colCount; ++i)
+		{
+			const std::vector<Entry> &cell = _cells[getCell(row, (colMin + i) % _cols)];
+			found.insert(found.end(), cell.begin(), cell.end());
+		}
+	}
+	std::sort(found.begin(), found.end(), [](const Entry &a, const Entry &b) { return a.order < b.order; });
+	result.reserve(found.size());
+	for (const Entry &e : found)
+	{
+		result.push_back(e.target);
+	}
+}
+
+/**
+ * Gets all targets in cells that overlap circle around given target.
+ * @param center Center of circle.
+ * @param range Great circle distance in radians.
+ * @param result Vector that get targets, old content is removed.
+ */
+void TargetGrid::query(const Target *center, double range, std::vector<Target*> &result) const
+{
+	query(center->getLongitude(), center->getLatitude(), range, result);
+}
+
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*
+ * Copyright 2010-2016 OpenXcom Developers.
+ *
+ * This file is part of OpenXcom.
+ *
+ * OpenXcom is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OpenXcom is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OpenXcom.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cstddef>
+#include <vector>
+
+namespace OpenXcom
+{
+
+class Target;
+
+/**
+ * Spatial index of targets on the globe, splits sphere into cells of equal
+ * latitude and longitude size. Query returns every target that could be in range,
+ * caller still needs to check exact distance, but can skip far away targets.
+ * Positions are copied on insert, grid need be rebuilt after targets move.
+ */
+class TargetGrid
+{
+	struct Entry
+	{
+		Target *target;
+		size_t order;
+	};
+	double _cellSize;
+	int _rows, _cols;
+	size_t _count;
+	std::vector<std::vector<Entry>> _cells;
+
+	/// Gets cell index of position.
+	size_t getCell(int row, int col) const { return (size_t)row * _cols + col; }
+	/// Gets row of latitude.
+	int getRow(double lat) const;
+	/// Gets column of longitude.
+	int getCol(double lon) const;
+public:
+	/// Creates empty grid with given cell size.
+	TargetGrid(double cellSize);
+	/// Removes all targets.
+	void clear();
+	/// Adds target at its current position.
+	void insert(Target *target);
+	/// Gets number of targets in grid.
+	size_t size() const { return _count; }
+	/// Gets targets that could be in range of given point, in insertion order.
+	void query(double lon, double lat, double range, std::vector<Target*> &result) const;
+	/// Gets targets that could be in range of given target, in insertion order.
+	void query(const Target *center, double range, std::vector<Target*> &result) const;
+};
+
+}
@@ -48,11 +48,30 @@ Tile::SerializationKey Tile::serializationKey =
  4 + 2*4 + 2*4 + 1 + 1 + 1 // total bytes to save one tile
 };
 
+/**
+ * Resets data of all tiles for a new map.
+ * @param size Number of tiles.
+ */
+void TileHotData::resize(int size)
+{
+	for (auto& layer : light)
+	{
+		layer.assign(size, 0);
+	}
+	fire.assign(size, 0);
+	smoke.assign(size, 0);
+	terrainLevel.assign(size, 0);
+	visible.assign(size, 0);
+	unit.assign(size, nullptr);
+}
+
 /**
  * constructor
  * @param pos Position.
+ * @param hot Storage of often used data of all tiles.
+ * @param index Index of tile in storage.
  */
-Tile::Tile(Position pos): _pos(pos), _unit(0), _visible(false), _preview(-1), _TUMarker(-1), _overlaps(0)
+Tile::Tile(Position pos, TileHotData *hot, int index): _index(index), _pos(pos), _hot(hot), _preview(-1), _TUMarker(-1), _overlaps(0)
 {
 	for (int i = 0; i < O_MAX; ++i)
 	{
@@ -61,10 +80,6 @@ Tile::Tile(Position pos): _pos(pos), _unit(0), _visible(false), _preview(-1), _T
 		_mapData->SetID[i] = -1;
 		_objectsCache[i].currentFrame = 0;
 	}
-	for (int layer = 0; layer < LL_MAX; layer++)
-	{
-		_light[layer] = 0;
-	}
 	for (int i = 0; i < O_MAX; ++i)
 	{
 		_objectsCache[i].discovered = 0;
@@ -92,8 +107,8 @@ void Tile::load(const YAML::Node &node)
 		_mapData->ID[i] = node["mapDataID"][i].as<int>(_mapData->ID[i]);
 		_mapData->SetID[i] = node["mapDataSetID"][i].as<int>(_mapData->SetID[i]);
 	}
-	_fire = node["fire"].as<int>(_fire);
-	_smoke = node["smoke"].as<int>(_smoke);
+	_hot->fire[_index] = node["fire"].as<int>(_hot->fire[_index]);
+	_hot->smoke[_index] = node["smoke"].as<int>(_hot->smoke[_index]);
 	if (node["discovered"])
 	{
 		for (int i = 0; i < 3; i++)
@@ -110,7 +125,7 @@ void Tile::load(const YAML::Node &node)
 	{
 		_objectsCache[2].currentFrame = 7;
 	}
-	if (_fire || _smoke)
+	if (_hot->fire[_index] || _hot->smoke[_index])
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
@@ -132,8 +147,8 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	_mapData->SetID[2] = unserializeInt(&buffer, serKey._mapDataSetID);
 	_mapData->SetID[3] = unserializeInt(&buffer, serKey._mapDataSetID);
 
-	_smoke = unserializeInt(&buffer, serKey._smoke);
-	_fire = unserializeInt(&buffer, serKey._fire);
+	_hot->smoke[_index] = unserializeInt(&buffer, serKey._smoke);
+	_hot->fire[_index] = unserializeInt(&buffer, serKey._fire);
 
 	Uint8 boolFields = unserializeInt(&buffer, serKey.boolFields);
 	_objectsCache[O_WESTWALL].discovered = (boolFields & 1) ? 1 : 0;
@@ -141,7 +156,7 @@ void Tile::loadBinary(Uint8 *buffer, Tile::SerializationKey& serKey)
 	_objectsCache[O_FLOOR].discovered = (boolFields & 4) ? 1 : 0;
 	_objectsCache[O_WESTWALL].currentFrame = (boolFields & 8) ? 7 : 0;
 	_objectsCache[O_NORTHWALL].currentFrame = (boolFields & 0x10) ? 7 : 0;
-	if (_fire || _smoke)
+	if (_hot->fire[_index] || _hot->smoke[_index])
 	{
 		_animationOffset = RNG::seedless(0, 3);
 	}
@@ -161,10 +176,10 @@ YAML::Node Tile::save() const
 		node["mapDataID"].push_back(_mapData->ID[i]);
 		node["mapDataSetID"].push_back(_mapData->SetID[i]);
 	}
-	if (_smoke)
-		node["smoke"] = _smoke;
-	if (_fire)
-		node["fire"] = _fire;
+	if (_hot->smoke[_index])
+		node["smoke"] = _hot->smoke[_index];
+	if (_hot->fire[_index])
+		node["fire"] = _hot->fire[_index];
 	if (_objectsCache[O_FLOOR].discovered || _objectsCache[O_WESTWALL].discovered || _objectsCache[O_NORTHWALL].discovered)
 	{
 		throw Exception("Obsolete code");
@@ -199,8 +214,8 @@ void Tile::saveBinary(Uint8** buffer) const
 	serializeInt(buffer, serializationKey._mapDataSetID, _mapData->SetID[2]);
 	serializeInt(buffer, serializationKey._mapDataSetID, _mapData->SetID[3]);
 
-	serializeInt(buffer, serializationKey._smoke, _smoke);
-	serializeInt(buffer, serializationKey._fire, _fire);
+	serializeInt(buffer, serializationKey._smoke, _hot->smoke[_index]);
+	serializeInt(buffer, serializationKey._fire, _hot->fire[_index]);
 
 	Uint8 boolFields = (_objectsCache[O_WESTWALL].discovered?1:0) + (_objectsCache[O_NORTHWALL].discovered?2:0) + (_objectsCache[O_FLOOR].discovered?4:0);
 	boolFields |= isUfoDoorOpen(O_WESTWALL) ? 8 : 0; // west
@@ -247,11 +262,32 @@ void Tile::setMapData(MapData *dat, int mapDataID, int mapDataSetID, TilePart pa
 		{
 			_cache.bigWall = 0;
 		}
-		_cache.terrainLevel = level;
+		_hot->terrainLevel[_index] = level;
 	}
+	updateVoxelLayers();
 	updateSprite(part);
 }
 
+/**
+ * Update cached mask of loft layers that have solid voxels in any tile part.
+ * Open ufo doors in walls do not block anything, so they are skipped.
+ */
+void Tile::updateVoxelLayers()
+{
+	Uint16 layers = 0;
+	for (int part = O_FLOOR; part < O_MAX; ++part)
+	{
+		TilePart tp = (TilePart)part;
+		if (((tp == O_WESTWALL) || (tp == O_NORTHWALL)) && isUfoDoorOpen(tp))
+			continue;
+		if (_objects[part])
+		{
+			layers |= _objects[part]->getVoxelLayers();
+		}
+	}
+	_cache.voxelLayers = layers;
+}
+
 /**
  * get the MapData references of part 0 to 3.
  * @param mapDataID
@@ -271,7 +307,7 @@ void Tile::getMapData(int *mapDataID, int *mapDataSetID, TilePart part) const
  */
 bool Tile::isVoid() const
 {
-	return _objects[0] == 0 && _objects[1] == 0 && _objects[2] == 0 && _objects[3] == 0 && _smoke == 0 && _inventory.empty();
+	return _objects[0] == 0 && _objects[1] == 0 && _objects[2] == 0 && _objects[3] == 0 && _hot->smoke[_index] == 0 && _inventory.empty();
 }
 
 /**
@@ -365,7 +401,7 @@ int Tile::openDoor(TilePart part, BattleUnit *unit, BattleActionType reserve, bo
 			return -1;
 		if (unit && cost.Time && !cost.haveTU())
 			return 4;
-		if (_unit && _unit != unit && _unit->getPosition() != getPosition())
+		if (getUnit() && getUnit() != unit && getUnit()->getPosition() != getPosition())
 			return -1;
 		setMapData(_objects[part]->getDataset()->getObject(_objects[part]->getAltMCD()), _objects[part]->getAltMCD(), _mapData->SetID[part],
 				   _objects[part]->getDataset()->getObject(_objects[part]->getAltMCD())->getObjectType());
@@ -377,6 +413,7 @@ int Tile::openDoor(TilePart part, BattleUnit *unit, BattleActionType reserve, bo
 		if (unit && cost.Time && !cost.haveTU())
 			return 4;
 		_objectsCache[part].currentFrame = 1; // start opening door
+		updateVoxelLayers();
 		updateSprite((TilePart)part);
 		return 1;
 	}
@@ -400,6 +437,10 @@ int Tile::closeUfoDoor()
 			updateSprite((TilePart)part);
 		}
 	}
+	if (retval)
+	{
+		updateVoxelLayers();
+	}
 
 	return retval;
 }
@@ -439,7 +480,7 @@ bool Tile::isDiscovered(TilePart part) const
  */
 void Tile::resetLight(LightLayers layer)
 {
-	_light[layer] = 0;
+	_hot->light[layer][_index] = 0;
 }
 
 /**
@@ -450,7 +491,7 @@ void Tile::resetLightMulti(LightLayers layer)
 {
 	for (int l = layer; l < LL_MAX; l++)
 	{
-		_light[l] = 0;
+		_hot->light[l][_index] = 0;
 	}
 }
 
@@ -461,8 +502,8 @@ void Tile::resetLightMulti(LightLayers layer)
  */
 void Tile::addLight(int light, LightLayers layer)
 {
-	if (_light[layer] < light)
-		_light[layer] = light;
+	if (_hot->light[layer][_index] < light)
+		_hot->light[layer][_index] = light;
 }
 
 /**
@@ -472,7 +513,7 @@ void Tile::addLight(int light, LightLayers layer)
  */
 int Tile::getLight(LightLayers layer) const
 {
-	return _light[layer];
+	return _hot->light[layer][_index];
 }
 
 int Tile::getLightMulti(LightLayers layer) const
@@ -481,8 +522,8 @@ int Tile::getLightMulti(LightLayers layer) const
 
 	for (int l = layer; l >= 0; --l)
 	{
-		if (_light[l] > light)
-			light = _light[l];
+		if (_hot->light[l][_index] > light)
+			light = _hot->light[l][_index];
 	}
 
 	return light;
@@ -500,8 +541,8 @@ int Tile::getShade() const
 
 	for (int layer = 0; layer < LL_MAX; layer++)
 	{
-		if (_light[layer] > light)
-			light = _light[layer];
+		if (_hot->light[layer][_index] > light)
+			light = _hot->light[layer][_index];
 	}
 
 	return std::max(0, 15 - light);
@@ -659,11 +700,11 @@ void Tile::ignite(int power)
 		}
 		if (RNG::percent(power) && getFuel())
 		{
-			if (_fire == 0)
+			if (_hot->fire[_index] == 0)
 			{
-				_smoke = 15 - Clamp(getFlammability() / 10, 1, 12);
+				_hot->smoke[_index] = 15 - Clamp(getFlammability() / 10, 1, 12);
 				_overlaps = 1;
-				_fire = getFuel() + 1;
+				_hot->fire[_index] = getFuel() + 1;
 				_animationOffset = RNG::generate(0,3);
 			}
 		}
@@ -674,9 +715,11 @@ void Tile::ignite(int power)
  * Animate the tile. This means to advance the current frame for every object.
  * Ufo doors are a bit special, they animated only when triggered.
  * When ufo doors are on frame 0(closed) or frame 7(open) they are not animated further.
+ * @return True if an opening ufo door stopped blocking movement.
  */
-void Tile::animate()
+bool Tile::animate()
 {
+	bool doorOpened = false;
 	int newframe;
 	for (int i = O_FLOOR; i < O_MAX; ++i)
 	{
@@ -695,10 +738,15 @@ void Tile::animate()
 			{
 				newframe = 0;
 			}
+			if (_objectsCache[i].isUfoDoor && _objectsCache[i].currentFrame <= 1 && newframe > 1)
+			{
+				doorOpened = true; // see getTUCost
+			}
 			_objectsCache[i].currentFrame = newframe;
 		}
 		updateSprite((TilePart)i);
 	}
+	return doorOpened;
 }
 
 /**
@@ -742,7 +790,7 @@ BattleUnit *Tile::getOverlappingUnit(const SavedBattleGame *saveBattleGame, Tile
  */
 void Tile::setFire(int fire)
 {
-	_fire = Clamp(fire, 0, 255);
+	_hot->fire[_index] = Clamp(fire, 0, 255);
 	_animationOffset = RNG::generate(0,3);
 }
 
@@ -752,7 +800,7 @@ void Tile::setFire(int fire)
  */
 int Tile::getFire() const
 {
-	return _fire;
+	return _hot->fire[_index];
 }
 
 /**
@@ -761,15 +809,15 @@ int Tile::getFire() const
  */
 void Tile::addSmoke(int smoke)
 {
-	if (_fire == 0)
+	if (_hot->fire[_index] == 0)
 	{
 		if (_overlaps == 0)
 		{
-			_smoke = Clamp(_smoke + smoke, 1, 15);
+			_hot->smoke[_index] = Clamp(_hot->smoke[_index] + smoke, 1, 15);
 		}
 		else
 		{
-			_smoke += smoke;
+			_hot->smoke[_index] += smoke;
 		}
 		_animationOffset = RNG::generate(0,3);
 		addOverlap();
@@ -782,7 +830,7 @@ void Tile::addSmoke(int smoke)
  */
 void Tile::setSmoke(int smoke)
 {
-	_smoke = Clamp(smoke, 0, 255);
+	_hot->smoke[_index] = Clamp(smoke, 0, 255);
 	_animationOffset = RNG::generate(0,3);
 }
 
@@ -793,7 +841,7 @@ void Tile::setSmoke(int smoke)
  */
 int Tile::getSmoke() const
 {
-	return _smoke;
+	return _hot->smoke[_index];
 }
 
 /**
@@ -891,17 +939,17 @@ static inline void applyEnvi(BattleUnit* unit, int smoke, int fire, bool smokeDa
 void Tile::prepareNewTurn(bool smokeDamage)
 {
 	// we've received new smoke in this turn, but we're not on fire, average out the smoke.
-	if ( _overlaps != 0 && _smoke != 0 && _fire == 0)
+	if ( _overlaps != 0 && _hot->smoke[_index] != 0 && _hot->fire[_index] == 0)
 	{
-		_smoke = Clamp((_smoke / _overlaps) - 1, 0, 15);
+		_hot->smoke[_index] = Clamp((_hot->smoke[_index] / _overlaps) - 1, 0, 15);
 	}
 	// if we still have smoke/fire
-	if (_smoke)
+	if (_hot->smoke[_index])
 	{
-		applyEnvi(_unit, _smoke, _fire, smokeDamage);
+		applyEnvi(getUnit(), _hot->smoke[_index], _hot->fire[_index], smokeDamage);
 		for (std::vector<BattleItem*>::iterator i = _inventory.begin(); i != _inventory.end(); ++i)
 		{
-			applyEnvi((*i)->getUnit(), _smoke, _fire, smokeDamage);
+			applyEnvi((*i)->getUnit(), _hot->smoke[_index], _hot->fire[_index], smokeDamage);
 		}
 	}
 	_overlaps = 0;
@@ -941,7 +989,7 @@ int Tile::getMarkerColor() const
  */
 void Tile::setVisible(int visibility)
 {
-	_visible += visibility;
+	_hot->visible[_index] += visibility;
 }
 
 /**
@@ -950,7 +998,7 @@ void Tile::setVisible(int visibility)
  */
 int Tile::getVisible() const
 {
-	return _visible;
+	return _hot->visible[_index];
 }
 
 /**
@@ -48,6 +48,30 @@ enum TileUnitOverlapping : int
 	TUO_ALWAYS = 0,
 };
 
+/**
+ * Often used data of all tiles of a battle map, stored in separate arrays indexed by tile index.
+ * Loops that need only one of these values can go through a single array
+ * instead of loading whole Tile objects, Tile accessors read and write these arrays.
+ */
+struct TileHotData
+{
+	/// Light of each layer.
+	std::vector<Uint8> light[LL_MAX];
+	/// Turns of fire left.
+	std::vector<Uint8> fire;
+	/// Smoke density.
+	std::vector<Uint8> smoke;
+	/// Height of terrain, see Tile::getTerrainLevel.
+	std::vector<Sint8> terrainLevel;
+	/// Number of player units that see tile.
+	std::vector<int> visible;
+	/// Unit standing on tile.
+	std::vector<BattleUnit*> unit;
+
+	/// Resets data for new map.
+	void resize(int size);
+};
+
 /**
  * Basic element of which a battle map is build.
  * @sa http://www.ufopaedia.org/index.php?title=MAPS
@@ -100,7 +124,7 @@ public:
 	 */
 	struct TileCache
 	{
-		Sint8 terrainLevel = 0;
+		Uint16 voxelLayers = 0;
 		Uint8 isNoFloor:1;
 		Uint8 bigWall:1;
 		Uint8 danger:1;
@@ -112,26 +136,25 @@ protected:
 	SurfaceRaw<const Uint8> _currentSurface[O_MAX] = { };
 	TileObjectCache _objectsCache[O_MAX] = { };
 	TileCache _cache = { };
-	Uint8 _light[LL_MAX];
-	Uint8 _fire = 0;
-	Uint8 _smoke = 0;
 	Uint8 _markerColor = 0;
 	Uint8 _animationOffset = 0;
 	Uint8 _obstacle = 0;
 	Uint8 _explosiveType = 0;
 	int _explosive = 0;
+	int _index;
 	Position _pos;
-	BattleUnit *_unit;
+	TileHotData *_hot;
 	std::vector<BattleItem *> _inventory;
-	int _visible;
 	int _preview;
 	int _TUMarker;
 	int _overlaps;
 
+	/// Update cached mask of terrain voxel layers.
+	void updateVoxelLayers();
 
 public:
 	/// Creates a tile.
-	Tile(Position pos);
+	Tile(Position pos, TileHotData *hot, int index);
 	/// Copy constructor.
 	Tile(Tile&&) = default;
 	/// Cleans up a tile.
@@ -199,7 +222,16 @@ public:
 	 */
 	int getTerrainLevel() const
 	{
-		return _cache.terrainLevel;
+		return _hot->terrainLevel[_index];
+	}
+
+	/**
+	 * Gets the mask of loft layers where any terrain part (except open ufo doors) has a solid voxel.
+	 * @return Bit mask, one bit per layer.
+	 */
+	Uint16 getVoxelLayers() const
+	{
+		return _cache.voxelLayers;
 	}
 
 	/**
@@ -296,7 +328,7 @@ public:
 	/// Get explosive power of this tile.
 	int getExplosiveType() const;
 	/// Animated the tile parts.
-	void animate();
+	bool animate();
 	/// Update cached value of sprite.
 	void updateSprite(TilePart part);
 	/// Get object sprites.
@@ -310,7 +342,7 @@ public:
 	 */
 	void setUnit(BattleUnit *unit)
 	{
-		_unit = unit;
+		_hot->unit[_index] = unit;
 	}
 
 	/**
@@ -319,7 +351,7 @@ public:
 	 */
 	BattleUnit *getUnit() const
 	{
-		return _unit;
+		return _hot->unit[_index];
 	}
 
 	/// Get unit from this tile or from tile below.
@@ -294,8 +294,9 @@ TransferType Transfer::getType() const
  * Advances the transfer and takes care of
  * the delivery once it's arrived.
  * @param base Pointer to destination base.
+ * @param mod Pointer to mod.
  */
-void Transfer::advance(Base *base)
+void Transfer::advance(Base *base, const Mod *mod)
 {
 	_hours--;
 	if (_hours <= 0)
@@ -312,7 +313,7 @@ void Transfer::advance(Base *base)
 		}
 		else if (_itemQty != 0)
 		{
-			base->getStorageItems()->addItem(_itemId, _itemQty);
+			base->getStorageItems()->addItem(mod->getItem(_itemId), _itemQty);
 		}
 		else if (_scientists != 0)
 		{
@@ -88,7 +88,7 @@ public:
 	/// Gets the type of the transfer.
 	TransferType getType() const;
 	/// Advances the transfer.
-	void advance(Base *base);
+	void advance(Base *base, const Mod *mod);
 	/// Get a pointer to the soldier being transferred.
 	Soldier *getSoldier();
 